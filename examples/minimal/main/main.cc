@@ -89,25 +89,32 @@ public:
         lv_obj_t *title = CreateLabel(parent, "List");
         lv_obj_align(title, LV_ALIGN_TOP_MID, 0, top);
         top += 40;
-        int card_w = ScreenWidth() - 48;
-        int card_h = 52;
-        for (int i = 0; i < kListCount; i++) {
-            lv_obj_t *card = CreateCard(parent, 24, top + i * (card_h + 8), card_w, card_h);
-            lv_obj_t *label = CreateLabel(card, kListItems[i]);
-            lv_obj_center(label);
-            card->user_data = reinterpret_cast<void *>(static_cast<intptr_t>(i));
-            AddEventHandler(card, OnItemClicked, LV_EVENT_CLICKED, nullptr);
-        }
-        top += kListCount * (card_h + 8) + 16;
+        /* Only the rows on screen exist; the same code scales to thousands of items */
+        lv_obj_t *list = CreateVirtualList(parent, kListCount, kRowH, CreateRow, BindRow, this);
+        lv_obj_set_size(list, LV_PCT(100), ScreenHeight() - top - 80);
+        lv_obj_set_pos(list, 0, top);
         lv_obj_t *back = CreateButton(parent, "Back to Home", OnBackClicked, this);
         lv_obj_align(back, LV_ALIGN_BOTTOM_MID, 0, -24);
     }
     void OnEnter() override { ESP_LOGI(TAG, "ListPage OnEnter"); }
     void OnLeave() override { ESP_LOGI(TAG, "ListPage OnLeave"); }
 private:
+    static const int kRowH = 60;
+    static void CreateRow(lv_obj_t *row, void *user_data) {
+        auto *self = static_cast<ListPage *>(user_data);
+        lv_obj_t *card = self->CreateCard(row, 24, 0, self->ScreenWidth() - 48, kRowH - 8);
+        lv_obj_center(self->CreateLabel(card, ""));
+        self->AddEventHandler(card, OnItemClicked, LV_EVENT_CLICKED, nullptr);
+    }
+    static void BindRow(lv_obj_t *row, uint32_t index, void *user_data) {
+        (void)user_data;
+        lv_obj_t *card = lv_obj_get_child(row, 0);
+        lv_label_set_text(lv_obj_get_child(card, 0), kListItems[index]);
+    }
     static void OnItemClicked(lv_event_t *e) {
-        lv_obj_t *target = lv_event_get_target(e);
-        int idx = static_cast<int>(reinterpret_cast<intptr_t>(target->user_data));
+        /* The row holds the item index */
+        lv_obj_t *row = lv_obj_get_parent(static_cast<lv_obj_t *>(lv_event_get_target(e)));
+        int idx = static_cast<int>(reinterpret_cast<intptr_t>(lv_obj_get_user_data(row)));
         if (idx >= 0 && idx < kListCount) {
             s_selected_list_index = idx;
             /* SlideOver: detail slides over the list page */
@@ -177,7 +184,7 @@ extern void app_main(void) {
     reg.RegisterPage(new HomePage());
     reg.RegisterPage(new SettingsPage());
     reg.RegisterPage(new ListPage());
-    reg.RegisterPage(new DetailPage());
+    reg.RegisterPage<DetailPage>("detail");  // constructed on first visit
 
     // 3) Gesture targets (left/right/up/down)
     using Nav = ui::PageNavigation;
@@ -0,0 +1,339 @@
+/**
+ * LVGL Nav Kit navigation benchmark (host build only).
+ * Registers synthetic pages of configurable widget counts and drives NavigateTo /
+ * NavigateBack through every TransitionType on the headless display, reporting
+ * create / transition / destroy wall time, frames, flushed pixels and LVGL heap peak.
+ *
+ * Usage: nav_bench [--widgets 10,50,200] [--iterations 5] [--duration 300]
+ *                  [--cache 0] [--size 320x240] [--snapshot off|outgoing|both]
+ *                  [--adaptive 0|1] [--batch 0|1]
+ */
+
+#include "lvgl_nav_kit/host_display.h"
+#include "lvgl_nav_kit/page_base.h"
+#include "lvgl_nav_kit/page_registry.h"
+#include "lvgl_nav_kit/ui_manager.h"
+#include "lvgl_nav_kit/ui_types.h"
+#include "lvgl.h"
+#include "esp_log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MsSince(Clock::time_point t0, Clock::time_point t1) {
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+uint32_t LvglHeapUsed() {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+/** Lifecycle timestamps written by the pages, read by the driver loop. */
+struct PageProbe {
+    bool created = false;
+    bool entered = false;
+    bool destroyed = false;
+    Clock::time_point create_end;
+    Clock::time_point enter;
+    Clock::time_point destroy_start;
+    Clock::time_point destroy_end;
+    uint32_t create_invalidations = 0;
+    void Reset() { created = entered = destroyed = false; }
+};
+
+uint32_t HostInvalidations() {
+    lvgl_nav_kit_host_stats_t stats;
+    lvgl_nav_kit_host_get_stats(&stats);
+    return stats.invalidations;
+}
+
+/** Page with `widgets` helper-created widgets laid out by a wrapping flex card. */
+class SyntheticPage : public ui::PageBase {
+public:
+    SyntheticPage(const char *id, int widgets, bool batch) : ui::PageBase(id), widgets_(widgets), batch_(batch) {
+        /* The batch is opened in OnCreate so create_end includes EndBatch's layout pass */
+        SetBatchedCreate(false);
+    }
+    PageProbe probe;
+    int Widgets() const { return widgets_; }
+    void OnCreate(lv_obj_t *parent) override {
+        uint32_t invalidations = HostInvalidations();
+        if (batch_) BeginBatch();
+        SetPageBackground(parent);
+        int top = GetStatusBarHeight();
+        lv_obj_t *body = CreateFlexCard(parent, 0, top, ScreenWidth(), ScreenHeight() - top, LV_FLEX_FLOW_ROW_WRAP);
+        lv_obj_add_flag(body, LV_OBJ_FLAG_SCROLLABLE);
+        char text[16];
+        for (int i = 0; i < widgets_; i++) {
+            snprintf(text, sizeof(text), "W%d", i);
+            switch (i % 4) {
+                case 0: CreateLabel(body, text); break;
+                case 1: CreateButton(body, text, nullptr); break;
+                case 2: CreateCheckbox(body, text, nullptr); break;
+                default: {
+                    lv_obj_t *card = CreateCard(body, 0, 0, 64, 32);
+                    lv_obj_center(CreateLabel(card, text));
+                    break;
+                }
+            }
+        }
+        /* Last child of the container is deleted last: marks the end of DoDestroy */
+        lv_obj_t *sentinel = lv_obj_create(parent);
+        lv_obj_set_size(sentinel, 0, 0);
+        lv_obj_add_event_cb(sentinel, OnSentinelDeleted, LV_EVENT_DELETE, &probe);
+        /* Same single layout pass either way, so only the batching differs */
+        if (batch_) EndBatch();
+        else lv_obj_update_layout(parent);
+        probe.create_invalidations = HostInvalidations() - invalidations;
+        probe.created = true;
+        probe.create_end = Clock::now();
+    }
+    void OnEnter() override {
+        probe.entered = true;
+        probe.enter = Clock::now();
+    }
+    void OnDestroy() override { probe.destroy_start = Clock::now(); }
+private:
+    static void OnSentinelDeleted(lv_event_t *e) {
+        PageProbe *p = (PageProbe *)lv_event_get_user_data(e);
+        p->destroyed = true;
+        p->destroy_end = Clock::now();
+    }
+    int widgets_;
+    bool batch_;
+};
+
+struct Options {
+    std::vector<int> widgets = {10, 50, 200};
+    int iterations = 5;
+    uint32_t duration_ms = 300;
+    int cache = 0;
+    int32_t hor_res = 320;
+    int32_t ver_res = 240;
+    ui::SnapshotMode snapshot = ui::SnapshotMode::Off;
+    bool adaptive = false;
+    bool batch = true;
+};
+
+struct Accum {
+    double sum = 0;
+    double max = 0;
+    int n = 0;
+    void Add(double v) { sum += v; max = std::max(max, v); n++; }
+    double Avg() const { return n ? sum / n : 0; }
+};
+
+struct RowStats {
+    Accum create_ms, create_inval, transition_ms, destroy_ms, frames, px_per_frame, max_frame_px, heap_peak_kb;
+};
+
+struct TransitionResult {
+    Clock::time_point t0;
+    uint32_t frames = 0;
+    uint64_t px = 0;
+    uint32_t max_frame_px = 0;
+    uint32_t heap_peak = 0;
+};
+
+/** Steps the simulated clock one refresh period at a time until `probe.entered`. */
+TransitionResult RunUntilEntered(const PageProbe &probe, uint32_t timeout_ms) {
+    TransitionResult r;
+    lvgl_nav_kit_host_reset_stats();
+    r.heap_peak = LvglHeapUsed();
+    uint32_t waited = 0;
+    while (!probe.entered && waited < timeout_ms) {
+        lvgl_nav_kit_host_run(LV_DEF_REFR_PERIOD);
+        waited += LV_DEF_REFR_PERIOD;
+        r.heap_peak = std::max(r.heap_peak, LvglHeapUsed());
+    }
+    /* One more period so the final frame of the transition is rendered and counted */
+    lvgl_nav_kit_host_run(LV_DEF_REFR_PERIOD);
+    lvgl_nav_kit_host_stats_t after;
+    lvgl_nav_kit_host_get_stats(&after);
+    r.frames = after.frames;
+    r.px = after.flushed_px;
+    r.max_frame_px = after.max_frame_px;
+    return r;
+}
+
+void Record(RowStats &row, const TransitionResult &r, const PageProbe &dest, uint32_t heap_base) {
+    if (dest.entered) row.transition_ms.Add(MsSince(r.t0, dest.enter));
+    row.frames.Add(r.frames);
+    row.px_per_frame.Add(r.frames ? (double)r.px / r.frames : 0);
+    row.max_frame_px.Add(r.max_frame_px);
+    row.heap_peak_kb.Add((r.heap_peak > heap_base ? r.heap_peak - heap_base : 0) / 1024.0);
+}
+
+const char *TypeName(ui::TransitionType t) {
+    switch (t) {
+        case ui::TransitionType::None: return "None";
+        case ui::TransitionType::Slide: return "Slide";
+        case ui::TransitionType::Fade: return "Fade";
+        case ui::TransitionType::SlideOver: return "SlideOver";
+        case ui::TransitionType::BufferScroll: return "BufScroll";
+    }
+    return "?";
+}
+
+void PrintCell(const Accum &a, const char *fmt) {
+    if (a.n) printf(fmt, a.Avg());
+    else printf("%10s", "-");
+}
+
+void PrintRow(const SyntheticPage &page, ui::TransitionType type, const char *way, const RowStats &s) {
+    printf("%-8s %7d %-9s %-4s", page.GetId(), page.Widgets(), TypeName(type), way);
+    PrintCell(s.create_ms, "%10.2f");
+    PrintCell(s.create_inval, "%8.0f");
+    PrintCell(s.transition_ms, "%10.2f");
+    PrintCell(s.destroy_ms, "%10.2f");
+    PrintCell(s.frames, "%8.1f");
+    PrintCell(s.px_per_frame, "%11.0f");
+    PrintCell(s.max_frame_px, "%10.0f");
+    PrintCell(s.heap_peak_kb, "%10.1f");
+    printf("\n");
+}
+
+bool ParseArgs(int argc, char **argv, Options &o) {
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        const char *v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!v) return false;
+        if (strcmp(a, "--widgets") == 0) {
+            o.widgets.clear();
+            for (const char *p = v; *p;) {
+                o.widgets.push_back(atoi(p));
+                const char *comma = strchr(p, ',');
+                if (!comma) break;
+                p = comma + 1;
+            }
+        } else if (strcmp(a, "--iterations") == 0) {
+            o.iterations = std::max(1, atoi(v));
+        } else if (strcmp(a, "--duration") == 0) {
+            o.duration_ms = (uint32_t)std::max(0, atoi(v));
+        } else if (strcmp(a, "--cache") == 0) {
+            o.cache = atoi(v);
+        } else if (strcmp(a, "--snapshot") == 0) {
+            if (strcmp(v, "off") == 0) o.snapshot = ui::SnapshotMode::Off;
+            else if (strcmp(v, "outgoing") == 0) o.snapshot = ui::SnapshotMode::Outgoing;
+            else if (strcmp(v, "both") == 0) o.snapshot = ui::SnapshotMode::Both;
+            else return false;
+        } else if (strcmp(a, "--adaptive") == 0) {
+            o.adaptive = atoi(v) != 0;
+        } else if (strcmp(a, "--batch") == 0) {
+            o.batch = atoi(v) != 0;
+        } else if (strcmp(a, "--size") == 0) {
+            int w = 0, h = 0;
+            if (sscanf(v, "%dx%d", &w, &h) != 2 || w <= 0 || h <= 0) return false;
+            o.hor_res = w;
+            o.ver_res = h;
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return !o.widgets.empty();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        fprintf(stderr, "usage: %s [--widgets 10,50,200] [--iterations N] [--duration ms] [--cache N] [--size WxH] [--snapshot off|outgoing|both] [--adaptive 0|1] [--batch 0|1]\n", argv[0]);
+        return 2;
+    }
+    /* Per-navigation INFO logs would dominate the timings */
+    esp_log_level_set("*", ESP_LOG_WARN);
+
+    lv_init();
+    if (!lvgl_nav_kit_host_display_create(opt.hor_res, opt.ver_res)) {
+        fprintf(stderr, "display init failed\n");
+        return 1;
+    }
+
+    auto &mgr = ui::UIManager::GetInstance();
+    mgr.Initialize(lv_screen_active(), nullptr);
+    mgr.SetTransitionDuration(opt.duration_ms);
+    mgr.SetMaxCachedPages(opt.cache);
+    mgr.SetSnapshotMode(opt.snapshot);
+    mgr.SetAdaptiveTransitions(opt.adaptive);
+    /* The headless display renders in DIRECT mode into one framebuffer */
+    mgr.SetScrollShiftCallback(lvgl_nav_kit_shift_direct_buffer);
+
+    auto &reg = mgr.GetRegistry();
+    SyntheticPage *home = new SyntheticPage("home", 4, opt.batch);
+    reg.RegisterPage(home);
+    std::vector<SyntheticPage *> pages;
+    for (size_t i = 0; i < opt.widgets.size(); i++) {
+        std::string id = "p" + std::to_string(opt.widgets[i]) + "_" + std::to_string(i);
+        pages.push_back(new SyntheticPage(id.c_str(), opt.widgets[i], opt.batch));
+        reg.RegisterPage(pages.back());
+    }
+
+    mgr.NavigateTo("home", ui::Direction::Right, ui::TransitionType::None);
+    lvgl_nav_kit_host_run(100);
+
+    const uint32_t timeout_ms = opt.duration_ms * 4 + 1000;
+    const ui::TransitionType types[] = {ui::TransitionType::None, ui::TransitionType::Slide,
+                                        ui::TransitionType::Fade, ui::TransitionType::SlideOver,
+                                        ui::TransitionType::BufferScroll};
+
+    printf("lvgl_nav_kit nav_bench: %dx%d, duration %u ms, cache %d, batch %d, %d iterations (averages; ms are wall time)\n",
+           (int)opt.hor_res, (int)opt.ver_res, (unsigned)opt.duration_ms, opt.cache, (int)opt.batch, opt.iterations);
+    printf("%-8s %7s %-9s %-4s%10s%8s%10s%10s%8s%11s%10s%10s\n", "page", "widgets", "type", "way",
+           "create", "inval", "transit", "destroy", "frames", "px/frame", "max_px", "heap_kb");
+
+    for (SyntheticPage *page : pages) {
+        for (ui::TransitionType type : types) {
+            RowStats fwd, back;
+            for (int it = 0; it < opt.iterations; it++) {
+                /* Forward: home -> page */
+                page->probe.Reset();
+                home->probe.Reset();
+                uint32_t heap_base = LvglHeapUsed();
+                Clock::time_point t0 = Clock::now();
+                mgr.NavigateTo(page->GetId(), ui::Direction::Left, type);
+                TransitionResult r = RunUntilEntered(page->probe, timeout_ms);
+                r.t0 = t0;
+                if (page->probe.created) {
+                    fwd.create_ms.Add(MsSince(t0, page->probe.create_end));
+                    fwd.create_inval.Add(page->probe.create_invalidations);
+                }
+                if (home->probe.destroyed) fwd.destroy_ms.Add(MsSince(home->probe.destroy_start, home->probe.destroy_end));
+                Record(fwd, r, page->probe, heap_base);
+
+                /* Back: page -> home (reversed direction, same transition type) */
+                page->probe.Reset();
+                home->probe.Reset();
+                heap_base = LvglHeapUsed();
+                t0 = Clock::now();
+                mgr.NavigateBack();
+                r = RunUntilEntered(home->probe, timeout_ms);
+                r.t0 = t0;
+                if (home->probe.created) {
+                    back.create_ms.Add(MsSince(t0, home->probe.create_end));
+                    back.create_inval.Add(home->probe.create_invalidations);
+                }
+                if (page->probe.destroyed) back.destroy_ms.Add(MsSince(page->probe.destroy_start, page->probe.destroy_end));
+                Record(back, r, home->probe, heap_base);
+            }
+            PrintRow(*page, type, "fwd", fwd);
+            PrintRow(*page, type, "back", back);
+        }
+    }
+
+    mgr.Shutdown();
+    lvgl_nav_kit_host_display_delete();
+    return 0;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file esp_log.h
+ * Host (non ESP-IDF) stand-in for the ESP-IDF logging API used by lvgl_nav_kit.
+ * Only on the include path of the host build; firmware builds use the real one.
+ */
+
+#ifndef LVGL_NAV_KIT_HOST_ESP_LOG_H
+#define LVGL_NAV_KIT_HOST_ESP_LOG_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE,
+} esp_log_level_t;
+
+/** Tag is ignored: the host shim keeps a single global level. */
+void esp_log_level_set(const char *tag, esp_log_level_t level);
+esp_log_level_t esp_log_level_get(const char *tag);
+/** Milliseconds since the first log call (wall clock, not the LVGL tick). */
+uint32_t esp_log_timestamp(void);
+
+#define ESP_LOG_LEVEL(level, letter, tag, format, ...)                                        \
+    do {                                                                                      \
+        if (esp_log_level_get(tag) >= (level)) {                                              \
+            fprintf(stderr, letter " (%u) %s: " format "\n", (unsigned)esp_log_timestamp(),   \
+                    (tag), ##__VA_ARGS__);                                                    \
+        }                                                                                     \
+    } while (0)
+
+#define ESP_LOGE(tag, format, ...) ESP_LOG_LEVEL(ESP_LOG_ERROR,   "E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) ESP_LOG_LEVEL(ESP_LOG_WARN,    "W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) ESP_LOG_LEVEL(ESP_LOG_INFO,    "I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) ESP_LOG_LEVEL(ESP_LOG_DEBUG,   "D", tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) ESP_LOG_LEVEL(ESP_LOG_VERBOSE, "V", tag, format, ##__VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LVGL_NAV_KIT_HOST_ESP_LOG_H */
@@ -0,0 +1,48 @@
+#ifndef LVGL_NAV_KIT_HOST_DISPLAY_H
+#define LVGL_NAV_KIT_HOST_DISPLAY_H
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Headless LVGL display for host builds: renders into a RAM framebuffer (RGB565,
+ * direct mode) and drives LVGL from a simulated tick, so runs are deterministic
+ * and independent of wall-clock speed.
+ */
+
+typedef struct lvgl_nav_kit_host_stats {
+    uint32_t frames;         /**< Completed refresh cycles (last flush of a frame) */
+    uint32_t flushes;        /**< flush_cb calls (one per invalidated area) */
+    uint64_t flushed_px;     /**< Total pixels handed to flush_cb */
+    uint32_t last_frame_px;  /**< Pixels flushed in the most recent frame */
+    uint32_t max_frame_px;   /**< Largest frame seen since the last reset */
+    uint32_t invalidations;  /**< Areas invalidated on screen (LV_EVENT_INVALIDATE_AREA) */
+} lvgl_nav_kit_host_stats_t;
+
+/** lv_init() must already have run. Creates the display and makes it the default. */
+lv_display_t *lvgl_nav_kit_host_display_create(int32_t hor_res, int32_t ver_res);
+void lvgl_nav_kit_host_display_delete(void);
+
+/** Advance the simulated tick by ms, running lv_timer_handler() at every due timer. */
+void lvgl_nav_kit_host_run(uint32_t ms);
+/** Simulated milliseconds since the display was created. */
+uint32_t lvgl_nav_kit_host_tick(void);
+
+/** Framebuffer in RGB565, hor_res * ver_res pixels, row stride = hor_res * 2 bytes. */
+const uint8_t *lvgl_nav_kit_host_framebuffer(void);
+
+void lvgl_nav_kit_host_get_stats(lvgl_nav_kit_host_stats_t *out);
+void lvgl_nav_kit_host_reset_stats(void);
+
+/** Simulated touch: pointer indev whose state is set by the caller between runs. */
+lv_indev_t *lvgl_nav_kit_host_pointer_create(void);
+void lvgl_nav_kit_host_pointer_set(int32_t x, int32_t y, bool pressed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LVGL_NAV_KIT_HOST_DISPLAY_H */
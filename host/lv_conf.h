@@ -0,0 +1,34 @@
+/**
+ * @file lv_conf.h
+ * LVGL configuration for the lvgl_nav_kit host build (headless, RGB565 like the
+ * SPI panels the kit targets). Anything not set here uses LVGL's defaults.
+ */
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#define LV_COLOR_DEPTH 16
+
+/* Built-in allocator so lv_mem_monitor() reports real heap usage */
+#define LV_USE_STDLIB_MALLOC    LV_STDLIB_BUILTIN
+#define LV_USE_STDLIB_STRING    LV_STDLIB_CLIB
+#define LV_USE_STDLIB_SPRINTF   LV_STDLIB_CLIB
+#define LV_MEM_SIZE             (512U * 1024U)
+
+#define LV_USE_OS               LV_OS_NONE
+#define LV_DEF_REFR_PERIOD      16
+#define LV_DPI_DEF              130
+
+#define LV_USE_LOG              0
+#define LV_USE_ASSERT_NULL      1
+#define LV_USE_ASSERT_MALLOC    1
+
+#define LV_USE_SNAPSHOT         1
+#define LV_USE_FLEX             1
+#define LV_USE_PERF_MONITOR     0
+#define LV_USE_MEM_MONITOR      0
+
+#define LV_FONT_MONTSERRAT_14   1
+#define LV_FONT_DEFAULT         &lv_font_montserrat_14
+
+#endif /* LV_CONF_H */
@@ -0,0 +1,37 @@
+/**
+ * @file esp_log.c
+ * Host logging shim: single global level, output to stderr.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "esp_log.h"
+#include <time.h>
+
+#ifndef LVGL_NAV_KIT_HOST_LOG_LEVEL
+#define LVGL_NAV_KIT_HOST_LOG_LEVEL ESP_LOG_INFO
+#endif
+
+static esp_log_level_t s_level = LVGL_NAV_KIT_HOST_LOG_LEVEL;
+
+void esp_log_level_set(const char *tag, esp_log_level_t level) {
+    (void)tag;
+    s_level = level;
+}
+
+esp_log_level_t esp_log_level_get(const char *tag) {
+    (void)tag;
+    return s_level;
+}
+
+uint32_t esp_log_timestamp(void) {
+    static int s_started = 0;
+    static struct timespec s_start;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (!s_started) {
+        s_start = now;
+        s_started = 1;
+    }
+    return (uint32_t)((now.tv_sec - s_start.tv_sec) * 1000 + (now.tv_nsec - s_start.tv_nsec) / 1000000);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file host_display.cc
+ * Headless display + simulated tick for host builds (benchmarks, CI).
+ */
+
+#include "lvgl_nav_kit/host_display.h"
+#include "lvgl_nav_kit/display.h"
+#include <cstdlib>
+#include <cstring>
+
+static lv_display_t *s_disp = nullptr;
+static uint8_t *s_fb = nullptr;
+static uint32_t s_tick = 0;
+static uint32_t s_frame_px = 0;
+static lvgl_nav_kit_host_stats_t s_stats;
+
+static int32_t s_pointer_x = 0;
+static int32_t s_pointer_y = 0;
+static bool s_pointer_pressed = false;
+
+static void host_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    (void)px_map; /* direct mode: LVGL already rendered into s_fb */
+    uint32_t px = (uint32_t)(area->x2 - area->x1 + 1) * (uint32_t)(area->y2 - area->y1 + 1);
+    s_stats.flushes++;
+    s_stats.flushed_px += px;
+    s_frame_px += px;
+    if (lv_display_flush_is_last(disp)) {
+        s_stats.frames++;
+        s_stats.last_frame_px = s_frame_px;
+        if (s_frame_px > s_stats.max_frame_px) s_stats.max_frame_px = s_frame_px;
+        s_frame_px = 0;
+    }
+    lv_display_flush_ready(disp);
+}
+
+static void host_invalidate_cb(lv_event_t *e) {
+    (void)e;
+    s_stats.invalidations++;
+}
+
+lv_display_t *lvgl_nav_kit_host_display_create(int32_t hor_res, int32_t ver_res) {
+    if (s_disp) return s_disp;
+    uint32_t size = (uint32_t)hor_res * (uint32_t)ver_res * 2;
+    s_fb = (uint8_t *)malloc(size);
+    if (!s_fb) return nullptr;
+    memset(s_fb, 0, size);
+    s_disp = lv_display_create(hor_res, ver_res);
+    if (!s_disp) {
+        free(s_fb);
+        s_fb = nullptr;
+        return nullptr;
+    }
+    lv_display_set_color_format(s_disp, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(s_disp, s_fb, nullptr, size, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(s_disp, host_flush_cb);
+    lv_display_add_event_cb(s_disp, host_invalidate_cb, LV_EVENT_INVALIDATE_AREA, nullptr);
+    lv_display_set_default(s_disp);
+    s_tick = 0;
+    lvgl_nav_kit_host_reset_stats();
+    return s_disp;
+}
+
+void lvgl_nav_kit_host_display_delete(void) {
+    if (!s_disp) return;
+    lv_display_delete(s_disp);
+    s_disp = nullptr;
+    free(s_fb);
+    s_fb = nullptr;
+}
+
+void lvgl_nav_kit_host_run(uint32_t ms) {
+    uint32_t remaining = ms;
+    for (;;) {
+        uint32_t next = lv_timer_handler();
+        if (remaining == 0) break;
+        /* Jump straight to the next due timer; never stall on a 0 ms reply */
+        uint32_t step = (next == LV_NO_TIMER_READY || next > remaining) ? remaining : next;
+        if (step == 0) step = 1;
+        lv_tick_inc(step);
+        s_tick += step;
+        remaining -= step;
+    }
+}
+
+uint32_t lvgl_nav_kit_host_tick(void) {
+    return s_tick;
+}
+
+const uint8_t *lvgl_nav_kit_host_framebuffer(void) {
+    return s_fb;
+}
+
+void lvgl_nav_kit_host_get_stats(lvgl_nav_kit_host_stats_t *out) {
+    if (out) *out = s_stats;
+}
+
+void lvgl_nav_kit_host_reset_stats(void) {
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_frame_px = 0;
+}
+
+static void host_pointer_read_cb(lv_indev_t *indev, lv_indev_data_t *data) {
+    (void)indev;
+    data->point.x = s_pointer_x;
+    data->point.y = s_pointer_y;
+    data->state = s_pointer_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+lv_indev_t *lvgl_nav_kit_host_pointer_create(void) {
+    return lvgl_nav_kit_add_pointer_indev(s_disp, host_pointer_read_cb, nullptr);
+}
+
+void lvgl_nav_kit_host_pointer_set(int32_t x, int32_t y, bool pressed) {
+    s_pointer_x = x;
+    s_pointer_y = y;
+    s_pointer_pressed = pressed;
+}
@@ -53,4 +53,20 @@ lv_indev_t *lvgl_nav_kit_add_pointer_indev(lv_display_t *disp,
                                            lv_indev_read_cb_t read_cb,
                                            void *user_data);
 
+/**
+ * Moves the pixels already shown in `area` by (dx, dy), as used by TransitionType::BufferScroll.
+ * Called on the LVGL task between frames; return false to fall back to a full redraw.
+ */
+typedef bool (*lvgl_nav_kit_scroll_shift_cb_t)(lv_display_t *disp, const lv_area_t *area,
+                                               int32_t dx, int32_t dy, void *user_data);
+
+/**
+ * Stock shift for single-buffered DIRECT render mode, where LVGL's one draw buffer keeps the
+ * last frame: waits for any flush still reading the buffer, memmoves in place, then flushes the
+ * moved area so panels with their own GRAM get it without LVGL rendering it again. Returns
+ * false (full redraw) in any other render mode or with two buffers.
+ */
+bool lvgl_nav_kit_shift_direct_buffer(lv_display_t *disp, const lv_area_t *area,
+                                      int32_t dx, int32_t dy, void *user_data);
+
 #endif /* LVGL_NAV_KIT_DISPLAY_H */
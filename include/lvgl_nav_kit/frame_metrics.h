@@ -0,0 +1,88 @@
+#ifndef LVGL_NAV_KIT_FRAME_METRICS_H
+#define LVGL_NAV_KIT_FRAME_METRICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "lvgl.h"
+#include "lvgl_nav_kit/ui_types.h"
+
+namespace ui {
+
+/** One display refresh recorded while a transition was running. Times in microseconds. */
+struct FrameSample {
+    TransitionType type = TransitionType::None;
+    uint32_t frame_us = 0;     /**< Refresh start to refresh ready (layout + render + flush) */
+    uint32_t render_us = 0;    /**< Drawing time, flush excluded */
+    uint32_t flush_us = 0;     /**< flush_cb calls plus waiting for the previous flush */
+    uint32_t interval_us = 0;  /**< Since the previous frame start (or the transition start) */
+    uint32_t dirty_px = 0;     /**< Pixels rendered and flushed this frame */
+};
+
+struct FramePercentiles {
+    uint32_t p50 = 0;
+    uint32_t p95 = 0;
+    uint32_t max = 0;
+};
+
+/** Aggregate for one TransitionType. Counters are cumulative; percentiles cover the ring buffer. */
+struct FrameStats {
+    uint32_t transitions = 0;
+    uint32_t frames = 0;
+    uint32_t dropped_frames = 0;  /**< Refresh periods skipped because a frame overran the budget */
+    FramePercentiles frame_us;
+    FramePercentiles render_us;
+    FramePercentiles flush_us;
+    FramePercentiles dirty_px;
+};
+
+/**
+ * FrameMetrics — opt-in per-frame instrumentation of page transitions, fed by the
+ * display's refresh/render/flush events. Owned by UIManager; see UIManager::EnableFrameMetrics.
+ */
+class FrameMetrics {
+public:
+    FrameMetrics() = default;
+    ~FrameMetrics();
+    FrameMetrics(const FrameMetrics &) = delete;
+    FrameMetrics &operator=(const FrameMetrics &) = delete;
+    void Enable(lv_display_t *disp, size_t capacity);
+    void Disable();
+    bool IsEnabled() const { return disp_ != nullptr; }
+    /** Expected frame period; longer intervals count as dropped frames. Default LV_DEF_REFR_PERIOD. */
+    void SetFrameBudget(uint32_t us) { frame_budget_us_ = us ? us : 1; }
+    uint32_t GetFrameBudget() const { return frame_budget_us_; }
+    void BeginTransition(TransitionType type);
+    /** The frame that draws the final position is still recorded after this call. */
+    void EndTransition();
+    /** Copies up to max samples, oldest first. Returns the number copied. */
+    size_t GetSamples(FrameSample *out, size_t max) const;
+    size_t GetSampleCount() const { return count_; }
+    FrameStats GetStats(TransitionType type) const;
+    void Reset();
+private:
+    static void DisplayEventCb(lv_event_t *e);
+    void OnDisplayEvent(lv_event_code_t code, lv_event_t *e);
+    void Push(const FrameSample &s);
+    lv_display_t *disp_ = nullptr;
+    uint32_t frame_budget_us_ = LV_DEF_REFR_PERIOD * 1000;
+    std::vector<FrameSample> ring_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    struct Counters { uint32_t transitions = 0, frames = 0, dropped = 0; };
+    Counters counters_[kTransitionTypeCount];
+    bool active_ = false;
+    bool closing_ = false;
+    TransitionType type_ = TransitionType::None;
+    int64_t last_start_us_ = 0;
+    int64_t refr_start_us_ = 0;
+    int64_t render_start_us_ = 0;
+    int64_t flush_start_us_ = 0;
+    int64_t wait_start_us_ = 0;
+    FrameSample cur_;
+    bool in_frame_ = false;
+};
+
+} // namespace ui
+
+#endif /* LVGL_NAV_KIT_FRAME_METRICS_H */
@@ -0,0 +1,72 @@
+#ifndef LVGL_NAV_KIT_MPSC_QUEUE_H
+#define LVGL_NAV_KIT_MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ui {
+
+/**
+ * MpscQueue — bounded lock-free queue for many producer tasks and one consumer.
+ * Each cell carries a sequence number (Vyukov's bounded queue): producers claim a slot
+ * with one compare-and-swap on tail_ and publish it by advancing the cell's sequence,
+ * so Push never blocks and never allocates. Pop must only be called from one task.
+ * N must be a power of two.
+ */
+template <typename T, size_t N>
+class MpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "MpscQueue size must be a power of two");
+public:
+    MpscQueue() {
+        for (size_t i = 0; i < N; i++) cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    /** Any task. Returns false when the queue is full. */
+    bool Push(const T &value) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        Cell *cell;
+        for (;;) {
+            cell = &cells_[pos & (N - 1)];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+            if (dif == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Consumer task only. Returns false when nothing is published yet. */
+    bool Pop(T &out) {
+        Cell &cell = cells_[head_ & (N - 1)];
+        size_t seq = cell.seq.load(std::memory_order_acquire);
+        if ((intptr_t)seq - (intptr_t)(head_ + 1) < 0) return false;
+        out = cell.value;
+        cell.seq.store(head_ + N, std::memory_order_release);
+        head_++;
+        return true;
+    }
+
+    static constexpr size_t Capacity() { return N; }
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T value;
+    };
+    Cell cells_[N];
+    std::atomic<size_t> tail_{0};
+    size_t head_ = 0;  /**< Consumer side only */
+};
+
+} // namespace ui
+
+#endif /* LVGL_NAV_KIT_MPSC_QUEUE_H */
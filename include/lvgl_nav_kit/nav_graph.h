@@ -0,0 +1,97 @@
+#ifndef LVGL_NAV_KIT_NAV_GRAPH_H
+#define LVGL_NAV_KIT_NAV_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include "lvgl_nav_kit/ui_types.h"
+
+namespace ui {
+
+class PageBase;
+
+struct NavTarget {
+    const char *page = nullptr;
+    Direction anim_dir = Direction::Right;
+    TransitionType anim_type = TransitionType::Slide;
+    PageBase *target = nullptr;  /**< Resolved by PageRegistry once `page` is registered */
+    constexpr NavTarget() = default;
+    constexpr NavTarget(const char *p) : page(p), anim_dir(Direction::Right), anim_type(TransitionType::Slide) {}
+    constexpr NavTarget(const char *p, Direction dir) : page(p), anim_dir(dir), anim_type(TransitionType::Slide) {}
+    constexpr NavTarget(const char *p, TransitionType type) : page(p), anim_dir(Direction::Right), anim_type(type) {}
+    constexpr NavTarget(const char *p, Direction dir, TransitionType type) : page(p), anim_dir(dir), anim_type(type) {}
+};
+
+struct PageNavigation {
+    NavTarget left, right, up, down;
+};
+
+/** One row of a compile-time page table: same edge syntax as PageRegistry::SetNavigation. */
+struct StaticNavPage {
+    const char *id;
+    PageNavigation nav;
+};
+
+/** Resolved edges of one page, indexed by (int)Direction of the gesture; -1 = no target. */
+struct StaticNavNode {
+    int16_t target[4];
+    Direction anim_dir[4];
+    TransitionType anim_type[4];
+};
+
+template <size_t N>
+struct StaticNavGraph {
+    const char *ids[N];
+    StaticNavNode nodes[N];
+    int error = -1;  /**< First page with an unknown target or a duplicate id */
+    constexpr bool IsValid() const { return error < 0; }
+};
+
+constexpr bool NavIdEqual(const char *a, const char *b) {
+    while (*a && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return *a == *b;
+}
+
+/**
+ * Resolve a page table into index edges at compile time:
+ *
+ *     static constexpr ui::StaticNavPage kPages[] = {
+ *         {"home",     { {"settings", D::Right}, {}, {}, {"list", D::Right} }},
+ *         {"settings", { {}, {"home", D::Left}, {}, {} }},
+ *         ...
+ *     };
+ *     static constexpr auto kGraph = ui::MakeNavGraph(kPages);
+ *     static_assert(kGraph.IsValid(), "navigation target missing from kPages");
+ *     reg.SetNavigationGraph(kGraph);
+ */
+template <size_t N>
+constexpr StaticNavGraph<N> MakeNavGraph(const StaticNavPage (&pages)[N]) {
+    static_assert(N < INT16_MAX, "too many pages");
+    StaticNavGraph<N> g{};
+    for (size_t i = 0; i < N; i++) {
+        g.ids[i] = pages[i].id;
+        for (size_t j = 0; j < i; j++) {
+            if (NavIdEqual(pages[j].id, pages[i].id) && g.error < 0) g.error = (int)i;
+        }
+        const PageNavigation &nav = pages[i].nav;
+        /* Direction order: Up, Down, Left, Right */
+        const NavTarget *edges[4] = {&nav.up, &nav.down, &nav.left, &nav.right};
+        for (int d = 0; d < 4; d++) {
+            g.nodes[i].target[d] = -1;
+            g.nodes[i].anim_dir[d] = edges[d]->anim_dir;
+            g.nodes[i].anim_type[d] = edges[d]->anim_type;
+            if (!edges[d]->page) continue;
+            for (size_t j = 0; j < N; j++) {
+                if (NavIdEqual(pages[j].id, edges[d]->page)) g.nodes[i].target[d] = (int16_t)j;
+            }
+            if (g.nodes[i].target[d] < 0 && g.error < 0) g.error = (int)i;
+        }
+    }
+    return g;
+}
+
+} // namespace ui
+
+#endif /* LVGL_NAV_KIT_NAV_GRAPH_H */
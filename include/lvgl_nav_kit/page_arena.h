@@ -0,0 +1,57 @@
+#ifndef LVGL_NAV_KIT_PAGE_ARENA_H
+#define LVGL_NAV_KIT_PAGE_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include "lvgl.h"
+
+namespace ui {
+
+/**
+ * PageArena — one block of memory that LVGL allocations are carved from while a page builds
+ * its widget tree, so a page's many small objects sit together instead of scattered over the
+ * LVGL heap, and come back as one block when the page is destroyed.
+ *
+ * LVGL has a single allocator with no per-object hook, so arenas need the component to be
+ * that allocator: set LV_USE_STDLIB_MALLOC to LV_STDLIB_CUSTOM and define
+ * LVGL_NAV_KIT_PAGE_ARENA 1 in lv_conf.h. lv_malloc then serves requests up to 256 bytes from
+ * the active arena's size classes and everything else (and overflow) from malloc. Without
+ * that configuration Create returns nullptr and pages use the LVGL heap as before.
+ *
+ * Allocations made during OnCreate that outlive the page (a global lv_style_t filled in by
+ * the page, say) keep the block alive after Release until they are freed, so nothing dangles.
+ */
+class PageArena {
+public:
+    static bool IsSupported();
+    /** nullptr when arenas are not compiled in or the block cannot be allocated. */
+    static PageArena *Create(uint32_t bytes);
+    /** Give the block back now, or once its last allocation is freed. */
+    static void Release(PageArena *arena);
+    /** Bytes LVGL has allocated through this component, headers included (0 if not compiled in). */
+    static uint32_t GetHeapUsed();
+    /** Route small LVGL allocations to arena (nullptr = general heap); returns the previous one. */
+    static PageArena *Activate(PageArena *arena);
+    uint32_t GetSize() const { return (uint32_t)(end_ - base_); }
+    /** Bytes handed out and not yet freed, headers included. */
+    uint32_t GetUsed() const { return used_; }
+    /** Requests that did not fit (too large or arena full) and went to the general heap. */
+    uint32_t GetFallbacks() const { return fallbacks_; }
+private:
+    friend struct PageArenaAllocator;
+    static constexpr size_t kClassCount = 8;
+    PageArena() = default;
+    uint8_t *base_ = nullptr;
+    uint8_t *bump_ = nullptr;
+    uint8_t *end_ = nullptr;
+    void *free_[kClassCount] = {};  /**< Freed blocks per size class, linked through their first word */
+    uint32_t live_ = 0;
+    uint32_t used_ = 0;
+    uint32_t fallbacks_ = 0;
+    bool released_ = false;
+    PageArena *next_ = nullptr;
+};
+
+} // namespace ui
+
+#endif /* LVGL_NAV_KIT_PAGE_ARENA_H */
@@ -1,6 +1,7 @@
 #ifndef LVGL_NAV_KIT_PAGE_BASE_H
 #define LVGL_NAV_KIT_PAGE_BASE_H
 
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <vector>
@@ -12,6 +13,7 @@ namespace ui {
 
 class UIManager;
 class PageRegistry;
+class PageArena;
 
 class PageBase {
     friend class UIManager;
@@ -23,17 +25,64 @@ public:
     virtual void OnEnter() {}
     virtual void OnLeave() {}
     virtual void OnDestroy() {}
+    /** Free heap fell below a UIManager watermark; drop whatever the page can rebuild later. */
+    virtual void OnLowMemory(MemoryPressure level) { (void)level; }
+    /** UIManager::PostToPage from another task, delivered on the LVGL task whatever the page state. */
+    virtual void OnMessage(uint32_t message, void *data) { (void)message; (void)data; }
+    /**
+     * Page-specific extras for UIManager::EnableStateRestore. Scroll positions, textarea text,
+     * dropdown/slider values and checked states are captured automatically; append anything
+     * else here. Restore runs after OnCreate, before OnEnter; for incremental pages it runs
+     * once instead, after the last OnCreateStep.
+     */
+    virtual void OnSaveState(std::vector<uint8_t> &out) { (void)out; }
+    virtual void OnRestoreState(const uint8_t *data, size_t size) { (void)data; (void)size; }
+    /**
+     * Optional incremental build for heavy pages that call SetIncrementalCreate(true): OnCreate
+     * builds what must show first, then UIManager calls this with step = 0, 1, 2... from an LVGL
+     * timer, as many per tick as fit its step budget. Return true while more steps remain.
+     * OnEnter may run before the last step.
+     */
+    virtual bool OnCreateStep(lv_obj_t *parent, uint32_t step) { (void)parent; (void)step; return false; }
+    bool IsCreateComplete() const { return !create_pending_; }
+    /** LVGL heap taken by DoCreate and any OnCreateStep calls (0 if not created or not measurable). */
+    uint32_t GetHeapFootprint() const { return heap_bytes_; }
+    /** Arena the widget tree was built in (UIManager::SetPageArenaSize), nullptr if none. */
+    const PageArena *GetArena() const { return arena_; }
     const char *GetId() const { return id_.c_str(); }
     lv_obj_t *GetContainer() const { return container_; }
     PageState GetState() const { return state_; }
     const ui_theme_t *GetTheme() const { return theme_; }
+    /**
+     * The Create* helpers share lv_style_t objects built once per theme. Call this after
+     * changing a theme's fields at runtime to rebuild them and restyle existing widgets.
+     */
+    static void RefreshThemeStyles(const ui_theme_t *theme);
+    /** Navigator that created the page (nullptr while not created); pages navigate through it. */
+    UIManager *GetManager() const { return manager_; }
 protected:
     lv_timer_t *CreateTimer(lv_timer_cb_t cb, uint32_t period, void *user_data = nullptr);
     void DeleteAllTimers();
+    /** Arena size for this page, e.g. set in the constructor for a heavy page; 0 = UIManager default. */
+    void SetArenaSize(uint32_t bytes) { arena_size_ = bytes; }
+    /**
+     * Bulk build or update: the container stays hidden until the matching EndBatch, so widget
+     * changes are not invalidated one by one and the Create* layout workarounds wait. EndBatch
+     * runs one layout pass, then shows the page with one invalidation. Calls nest. OnCreate runs
+     * in a batch (see SetBatchedCreate); wrap bulk updates in OnEnter or OnCreateStep by hand.
+     */
+    void BeginBatch();
+    void EndBatch();
+    /** Run OnCreate outside a batch; on by default. */
+    void SetBatchedCreate(bool enable) { batched_create_ = enable; }
+    /** Have OnCreateStep called after OnCreate, e.g. set in the constructor; off by default. */
+    void SetIncrementalCreate(bool enable) { incremental_create_ = enable; }
     void AddEventHandler(lv_obj_t *obj, lv_event_cb_t cb, lv_event_code_t code, void *user_data = nullptr);
-    static bool IsLargeScreen() { return LV_HOR_RES >= 720; }
-    static int ScreenWidth() { return LV_HOR_RES; }
-    static int ScreenHeight() { return LV_VER_RES; }
+    /** Display the page is on; the default display before it is created. */
+    lv_display_t *GetDisplay() const { return container_ ? lv_obj_get_display(container_) : lv_display_get_default(); }
+    bool IsLargeScreen() const { return ScreenWidth() >= 720; }
+    int ScreenWidth() const { return lv_display_get_horizontal_resolution(GetDisplay()); }
+    int ScreenHeight() const { return lv_display_get_vertical_resolution(GetDisplay()); }
     int GetStatusBarHeight() const;
     lv_obj_t *CreateLabel(lv_obj_t *parent, const char *text);
     lv_obj_t *CreateButton(lv_obj_t *parent, const char *text, lv_event_cb_t cb, void *user_data = nullptr);
@@ -49,6 +98,19 @@ protected:
     lv_obj_t *CreateKeyboard(lv_obj_t *parent, lv_keyboard_mode_t mode = LV_KEYBOARD_MODE_NUMBER);
     lv_obj_t *CreateDialog(int w, int h, uint32_t border_color = 0);
     void CreateInfoRow(lv_obj_t *parent, int y, const char *icon, const char *title, const char *value, uint32_t color, lv_obj_t **value_label);
+    using VirtualRowCreateCb = void (*)(lv_obj_t *row, void *user_data);
+    using VirtualRowBindCb = void (*)(lv_obj_t *row, uint32_t index, void *user_data);
+    /**
+     * Vertically scrolling list of item_count rows, row_height px each, that keeps only the
+     * visible rows plus two above and below as objects and rebinds them while scrolling.
+     * create_row (optional) builds a row's children once; bind_row fills them for an item.
+     * A row's user_data holds its item index. Size and place the returned list as usual.
+     * item_count is capped at LV_COORD_MAX / row_height, the longest scroll range LVGL can hold.
+     */
+    lv_obj_t *CreateVirtualList(lv_obj_t *parent, uint32_t item_count, int32_t row_height,
+                                VirtualRowCreateCb create_row, VirtualRowBindCb bind_row, void *user_data = nullptr);
+    /** The data behind list changed: set the new count and rebind the visible rows. */
+    static void SetVirtualListCount(lv_obj_t *list, uint32_t item_count);
     void ShowLoading(const char *text = "Loading...");
     void HideLoading();
     bool IsLoading() const { return loading_overlay_ != nullptr; }
@@ -62,11 +124,28 @@ private:
     void DoEnter();
     void DoLeave();
     void DoCreate(lv_obj_t *parent, const ui_theme_t *theme);
+    bool DoCreateStep();
+    void SaveState(std::vector<uint8_t> &out);
+    void RestoreState(const std::vector<uint8_t> &in);
     void DoDestroy();
     const ui_theme_t *theme_ = nullptr;
+    UIManager *manager_ = nullptr;
     std::vector<lv_timer_t *> timers_;
     struct EventBinding { lv_obj_t *obj; lv_event_cb_t cb; };
     std::vector<EventBinding> event_bindings_;
+    bool create_pending_ = false;
+    bool incremental_create_ = false;
+    bool batched_create_ = true;
+    uint32_t batch_depth_ = 0;
+    bool batch_hid_ = false;  /**< BeginBatch hid the container, EndBatch shows it */
+    std::vector<lv_obj_t *> batch_dropdowns_;  /**< Waiting for their list style until EndBatch */
+    uint32_t create_step_ = 0;
+    uint32_t heap_bytes_ = 0;
+    PageArena *arena_ = nullptr;
+    uint32_t arena_size_ = 0;
+    uint32_t id_hash_ = 0;
+    int nav_index_ = -1;
+    int graph_index_ = -1;
 };
 
 } // namespace ui
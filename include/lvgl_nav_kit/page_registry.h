@@ -1,41 +1,100 @@
 #ifndef LVGL_NAV_KIT_PAGE_REGISTRY_H
 #define LVGL_NAV_KIT_PAGE_REGISTRY_H
 
-#include <map>
+#include <cstdint>
 #include <string>
+#include <type_traits>
+#include <vector>
+#include "lvgl_nav_kit/nav_graph.h"
 #include "lvgl_nav_kit/page_base.h"
 #include "lvgl_nav_kit/ui_types.h"
 
 namespace ui {
 
-struct NavTarget {
-    const char *page = nullptr;
-    Direction anim_dir = Direction::Right;
-    TransitionType anim_type = TransitionType::Slide;
-    NavTarget() = default;
-    NavTarget(const char *p) : page(p), anim_dir(Direction::Right), anim_type(TransitionType::Slide) {}
-    NavTarget(const char *p, Direction dir) : page(p), anim_dir(dir), anim_type(TransitionType::Slide) {}
-    NavTarget(const char *p, TransitionType type) : page(p), anim_dir(Direction::Right), anim_type(type) {}
-    NavTarget(const char *p, Direction dir, TransitionType type) : page(p), anim_dir(dir), anim_type(type) {}
-};
-
-struct PageNavigation {
-    NavTarget left, right, up, down;
-};
-
+/**
+ * PageRegistry — owns the pages and their swipe graph. Ids are hashed once at RegisterPage
+ * into a flat open-addressed table, and NavTarget::target is resolved when either end is
+ * registered, so lookups and gestures neither allocate nor walk string maps.
+ *
+ * Pages registered with a factory are constructed on first lookup (GetPage, a swipe or a
+ * preload) and deleted again by Unload, which UIManager calls when it evicts them from its
+ * cache. Lookups of a constructed page are as cheap as for an eager one.
+ */
 class PageRegistry {
 public:
+    using PageFactory = PageBase *(*)(const char *id);
+    /** Answers whether a navigator still refers to page (history, queue, screen). */
+    using InUseCheck = bool (*)(const PageBase *page, void *user_data);
     PageRegistry();
     ~PageRegistry();
     void RegisterPage(PageBase *page);
+    /** Lazy page: factory runs on first lookup. id must have static storage (e.g. a literal). */
+    void RegisterPage(const char *id, PageFactory factory);
+    /** Lazy page of type T, built with T(id) if it has that constructor, else T(). */
+    template <typename T>
+    void RegisterPage(const char *id) { RegisterPage(id, &MakePage<T>); }
+    /** Looks up a page, constructing it if it was registered with a factory. */
     PageBase *GetPage(const char *id);
+    /** True when id is registered and its object exists. */
+    bool IsLoaded(const char *id) const;
+    /**
+     * Delete a factory page's object, keeping its registration. Refused for eager pages, pages
+     * still created, and pages an InUseCheck reports as referenced. Returns true if deleted.
+     */
+    bool Unload(PageBase *page);
+    void AddInUseCheck(InUseCheck check, void *user_data);
+    void RemoveInUseCheck(void *user_data);
     void SetNavigation(const char *page_id, const PageNavigation &nav);
+    /** Swipe targets of page_id, or nullptr if none were set. */
+    const PageNavigation *GetNavigation(const char *page_id) const;
+    const PageNavigation *GetNavigation(const PageBase *page) const;
     bool GetNavigationTarget(const char *page_id, Direction gesture_dir, PageBase *&out_target, Direction &out_anim_dir, TransitionType &out_anim_type);
+    /** Constructs the target if it is a factory page not loaded yet. */
+    bool GetNavigationTarget(const PageBase *page, Direction gesture_dir, PageBase *&out_target, Direction &out_anim_dir, TransitionType &out_anim_type);
+    /** Swipe target of page in gesture_dir from either the static graph or SetNavigation. */
+    PageBase *GetNeighbor(const PageBase *page, Direction gesture_dir);
+    /**
+     * Use a MakeNavGraph table (must have static storage, e.g. `static constexpr`) for the
+     * pages it lists; SetNavigation still covers pages outside it. The table stays in flash,
+     * only one PageBase pointer per entry is kept in RAM.
+     */
+    template <size_t N>
+    void SetNavigationGraph(const StaticNavGraph<N> &graph) { SetNavigationGraph(graph.ids, graph.nodes, N); }
+    void SetNavigationGraph(const char *const *ids, const StaticNavNode *nodes, size_t count);
     void Clear();
-    size_t GetPageCount() const { return id_map_.size(); }
+    size_t GetPageCount() const { return count_; }
+    /** FNV-1a of a page id. */
+    static uint32_t HashId(const char *id);
 private:
-    std::map<std::string, PageBase *> id_map_;
-    std::map<std::string, PageNavigation> navigation_map_;
+    struct Slot {
+        uint32_t hash = 0;
+        const char *id = nullptr;  /**< Factory id, or the page's own id; nullptr = empty slot */
+        PageBase *page = nullptr;  /**< nullptr while a factory page is not loaded */
+        PageFactory factory = nullptr;
+    };
+    template <typename T>
+    static PageBase *MakePage(const char *id) {
+        if constexpr (std::is_constructible<T, const char *>::value) return new T(id);
+        else { (void)id; return new T(); }
+    }
+    struct NavEntry {
+        std::string page_id;
+        PageNavigation nav;
+    };
+    size_t FindSlot(const char *id, uint32_t hash) const;
+    PageBase *Find(const char *id) const;
+    PageBase *Load(Slot &slot);
+    void Attach(PageBase *page);
+    void Grow();
+    void Resolve(PageNavigation &nav);
+    std::vector<Slot> slots_;  /**< Power-of-two size, linear probing, at most half full */
+    size_t count_ = 0;
+    std::vector<NavEntry> navs_;
+    const char *const *graph_ids_ = nullptr;
+    const StaticNavNode *graph_nodes_ = nullptr;
+    std::vector<PageBase *> graph_pages_;  /**< Registered page per graph entry, nullptr if not loaded */
+    struct InUse { InUseCheck check; void *user_data; };
+    std::vector<InUse> in_use_;
 };
 
 } // namespace ui
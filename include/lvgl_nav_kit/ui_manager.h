@@ -2,9 +2,13 @@
 #define LVGL_NAV_KIT_UI_MANAGER_H
 
 #include <functional>
+#include <map>
 #include <string>
 #include <vector>
 #include "lvgl.h"
+#include "lvgl_nav_kit/display.h"
+#include "lvgl_nav_kit/frame_metrics.h"
+#include "lvgl_nav_kit/mpsc_queue.h"
 #include "lvgl_nav_kit/page_registry.h"
 #include "lvgl_nav_kit/ui_theme.h"
 #include "lvgl_nav_kit/ui_types.h"
@@ -12,68 +16,368 @@
 namespace ui {
 
 /**
- * UIManager — singleton that manages page navigation, transitions, and gestures.
+ * UIManager — manages page navigation, transitions, and gestures on one screen.
+ * GetInstance() is the default navigator; devices with several panels construct one
+ * UIManager per display, each with its own registry or sharing one (see the constructor).
  *
- * Thread safety: all public methods must be called from the LVGL task (or while
- * holding the LVGL lock when using esp_lvgl_port). Calling from other tasks
- * without proper locking leads to undefined behaviour.
+ * Thread safety: all public methods except the Post* family must be called from the
+ * LVGL task (or while holding the LVGL lock when using esp_lvgl_port). Calling from
+ * other tasks without proper locking leads to undefined behaviour. Post* may be called
+ * from any task without the lock; see PostNavigate.
  */
 class UIManager {
 public:
     static UIManager &GetInstance();
+    /**
+     * shared_registry = nullptr gives the navigator its own PageRegistry. Navigators sharing
+     * one use the same pages and swipe graph; a page lives on one display at a time, so
+     * navigating to a page cached by another navigator takes it over, and one that is on
+     * screen there is refused. The shared registry must outlive its navigators.
+     */
+    explicit UIManager(PageRegistry *shared_registry = nullptr);
+    ~UIManager();
     void Initialize(lv_obj_t *parent, const ui_theme_t *theme = nullptr);
+    /** Initialize on the active screen of disp. */
+    void Initialize(lv_display_t *disp, const ui_theme_t *theme = nullptr);
     void Shutdown();
     bool IsInitialized() const { return initialized_; }
     PageRegistry &GetRegistry() { return registry_; }
+    lv_display_t *GetDisplay() const { return page_container_ ? lv_obj_get_display(page_container_) : nullptr; }
+    /**
+     * Only take gestures and drags from indev (nullptr = any input device that reaches this
+     * screen). Route the indev to this display with lv_indev_set_display.
+     */
+    void SetInputDevice(lv_indev_t *indev) { indev_ = indev; }
     void NavigateTo(const char *page_id, Direction dir = Direction::Right, TransitionType type = TransitionType::Slide);
     void NavigateToWithFade(const char *page_id);
     void NavigateBack();
+    /** Go back to the most recent history entry for page_id, dropping the entries above it. */
+    void NavigateBackTo(const char *page_id);
+    /** Go back to the oldest page in history and clear it. */
+    void PopToRoot();
+    /** Navigate to page_id without recording the current page, so Back skips it. */
+    void ReplaceCurrent(const char *page_id, Direction dir = Direction::Right, TransitionType type = TransitionType::Fade);
+    /**
+     * Cross-task navigation: queue the call in a lock-free mailbox (16 commands) that the LVGL
+     * task drains every refresh period, so producer tasks never take the LVGL lock. Page ids
+     * are copied (at most 31 characters). Returns false when the mailbox is full or the id
+     * too long; the command is dropped. Safe from any task, not from ISRs.
+     */
+    bool PostNavigate(const char *page_id, Direction dir = Direction::Right, TransitionType type = TransitionType::Slide);
+    bool PostBack();
+    bool PostBackTo(const char *page_id);
+    /** Deliver message and data to PageBase::OnMessage of page_id on the LVGL task; data is not copied. */
+    bool PostToPage(const char *page_id, uint32_t message, void *data = nullptr);
+    /** Handling of navigations requested mid-transition (default LatestWins); queue holds 8. */
+    void SetNavQueuePolicy(NavQueuePolicy policy);
+    /**
+     * With interruptible transitions, NavigateBack (or a navigation/swipe to the page being
+     * left) during a transition runs it backwards from where it is, in the time it took to get
+     * there; any other navigation fast-forwards it to the end and is queued. Default off.
+     */
+    void SetInterruptibleTransitions(bool enable) { interruptible_ = enable; }
+    bool IsInterruptibleTransitions() const { return interruptible_; }
+    /** Jump the running transition to its final frame; it completes on the next LVGL tick. */
+    void FinishTransition();
+    /** Run the running transition backwards from its current position. False if none runs. */
+    bool ReverseTransition();
+    NavQueuePolicy GetNavQueuePolicy() const { return nav_queue_policy_; }
+    size_t GetPendingNavigations() const { return nav_queue_count_; }
+    void ClearPendingNavigations() { nav_queue_count_ = 0; }
+    /**
+     * Entries kept for NavigateBack (default 10; the oldest is dropped when full).
+     * 0 = unbounded: the ring grows, allocating only when it doubles.
+     */
+    void SetHistoryDepth(size_t depth);
+    size_t GetHistorySize() const { return history_count_; }
     PageBase *GetCurrentPage() const { return current_page_; }
     void SetTransitionType(TransitionType type);
     void SetTransitionDuration(uint32_t ms);
     void EnableGesture(bool enable);
+    /**
+     * Drag-to-navigate: a press-and-drag on the page background moves the current page and its
+     * swipe neighbour (Slide/SlideOver/BufferScroll targets) with the finger; on release the
+     * transition commits or springs back depending on distance and speed. Default off.
+     */
+    void EnableDragTracking(bool enable);
     /** Set max inactive pages kept in memory. -1 = unlimited (default), 0 = destroy immediately. */
     void SetMaxCachedPages(int n);
+    /**
+     * Cap the LVGL heap held by inactive pages (PageBase::GetHeapFootprint). Eviction picks the
+     * page with the largest footprint x recency rank, so old and large pages go first.
+     * 0 = no byte cap (default). Applies together with SetMaxCachedPages.
+     */
+    void SetCacheBudget(uint32_t bytes);
+    uint32_t GetCachedBytes() const;
+    /**
+     * Save widget state (PageBase::OnSaveState) when a cached page is destroyed and replay it
+     * on the next creation, so a small cache does not lose scroll positions or typed input.
+     */
+    void EnableStateRestore(bool enable);
+    /** Forget saved state for page_id, or for all pages when nullptr. */
+    void ClearSavedState(const char *page_id = nullptr);
+    /**
+     * Shed memory when free LVGL heap drops below low_bytes: preloaded pages first, then cached
+     * pages (least recently used first) until free heap is back above low_bytes, then snapshot
+     * buffers. Below critical_bytes every cached page goes. Pages still alive are told via
+     * PageBase::OnLowMemory when the level rises. Checked periodically and before each page
+     * creation. 0, 0 = off (default).
+     */
+    void SetMemoryWatermarks(uint32_t low_bytes, uint32_t critical_bytes);
+    /** Also watch a system heap, e.g. a probe returning esp_get_free_heap_size(), with its own watermarks. */
+    void SetSystemHeapProbe(uint32_t (*probe)(void *user_data), void *user_data, uint32_t low_bytes, uint32_t critical_bytes);
+    MemoryPressure GetMemoryPressure() const { return pressure_; }
+    /** Re-read free heap and shed now; returns the level seen before shedding. */
+    MemoryPressure CheckMemoryPressure();
+    /**
+     * Build each page's widget tree (OnCreate, OnCreateStep, state restore) in its own arena of
+     * this many bytes, returned in one piece on destroy so cycling pages does not fragment the
+     * heap. Needs the allocator described in page_arena.h. 0 = off (default).
+     */
+    void SetPageArenaSize(uint32_t bytes) { page_arena_size_ = bytes; }
+    /** Wall-clock ms per timer tick spent in PageBase::OnCreateStep (default 4). */
+    void SetCreateStepBudget(uint32_t ms) { create_step_budget_ms_ = ms ? ms : 1; }
+    /**
+     * Pre-create the swipe neighbours (PageRegistry navigation) of the current page, hidden,
+     * one per idle tick after a navigation settles, so the first swipe does not pay for
+     * DoCreate. budget_bytes caps the LVGL heap held by preloaded pages (0 = neighbours only).
+     */
+    void EnablePreload(bool enable, uint32_t budget_bytes = 0);
+    /**
+     * Slide/SlideOver move snapshot images instead of live widget trees (needs LV_USE_SNAPSHOT).
+     * Keeps up to two page-sized draw buffers on the LVGL heap; falls back to live pages if
+     * a snapshot cannot be taken.
+     */
+    void SetSnapshotMode(SnapshotMode mode);
+    SnapshotMode GetSnapshotMode() const { return snapshot_mode_; }
+    /**
+     * Adapt transitions to the frame rate actually achieved (measured on the LVGL tick while
+     * animating): positions are quantized to one evenly spaced step per frame instead of
+     * jumping by however much time a slow frame took. When fewer than min_steps frames fit in
+     * the duration the transition is shortened to a single frame rather than stuttering.
+     */
+    void SetAdaptiveTransitions(bool enable, uint32_t min_steps = 4);
+    bool IsAdaptiveTransitions() const { return adaptive_; }
+    /** Smoothed frame period seen during transitions, ms. */
+    uint32_t GetMeasuredFramePeriod() const { return frame_period_x16_ / 16; }
+    /**
+     * Pixel mover for TransitionType::BufferScroll, e.g. lvgl_nav_kit_shift_direct_buffer.
+     * Without one (or when it returns false) BufferScroll redraws like Slide.
+     */
+    void SetScrollShiftCallback(lvgl_nav_kit_scroll_shift_cb_t cb, void *user_data = nullptr);
     TransitionType GetTransitionType() const { return transition_type_; }
     uint32_t GetTransitionDuration() const { return transition_duration_; }
     const ui_theme_t *GetTheme() const { return theme_; }
+    /** Record per-frame render/flush time and dirty area during transitions (off by default). */
+    void EnableFrameMetrics(bool enable, size_t capacity = 128);
+    FrameMetrics &GetFrameMetrics() { return frame_metrics_; }
 private:
-    UIManager();
-    ~UIManager();
     UIManager(const UIManager &) = delete;
     UIManager &operator=(const UIManager &) = delete;
     void DoNavigate(PageBase *target, Direction dir, TransitionType type, bool record_history = true);
+    bool ClaimPage(PageBase *page);
+    bool HoldsPage(const PageBase *page) const;
+    void ReleasePage(PageBase *page);
+    struct HistoryEntry {
+        PageBase *page = nullptr;
+        Direction dir = Direction::Right;
+        TransitionType type = TransitionType::Slide;
+    };
+    void PushHistory(const HistoryEntry &entry);
+    HistoryEntry &HistoryFromTop(size_t i) { return history_[(history_head_ + history_.size() - 1 - i) % history_.size()]; }
+    void GoBack(size_t entries, bool animate = true);
+    bool BackToPage(PageBase *target, bool animate);
+    struct NavRequest {
+        enum class Kind : uint8_t { To, Replace, Back, BackTo, Root } kind = Kind::To;
+        PageBase *page = nullptr;
+        Direction dir = Direction::Right;
+        TransitionType type = TransitionType::Slide;
+        /* To/Replace aimed at p; a no-op when p is already shown or being entered (double tap) */
+        bool Targets(const PageBase *p) const { return (kind == Kind::To || kind == Kind::Replace) && page == p; }
+    };
+    static constexpr size_t kPostedIdLen = 32;
+    struct PostedCommand {
+        enum class Kind : uint8_t { Navigate, Back, BackTo, Message } kind = Kind::Navigate;
+        Direction dir = Direction::Right;
+        TransitionType type = TransitionType::Slide;
+        uint32_t message = 0;
+        void *data = nullptr;
+        char page_id[kPostedIdLen] = {};
+    };
+    bool Post(PostedCommand &cmd, const char *page_id);
+    static void MailboxTimerCb(lv_timer_t *t);
+    void DrainMailbox();
+    bool QueueIfBusy(const NavRequest &req);
+    void RunNavRequest(const NavRequest &req, bool animate);
+    void DrainNavQueue();
     void DoSlideTransition(lv_obj_t *old_obj, lv_obj_t *new_obj, PageBase *old_page, PageBase *target, Direction dir);
     void DoSlideOverTransition(lv_obj_t *old_obj, lv_obj_t *new_obj, PageBase *old_page, PageBase *target, Direction dir);
     void DoFadeTransition(lv_obj_t *old_obj, lv_obj_t *new_obj, PageBase *old_page, PageBase *target);
+    void DoBufferScrollTransition(lv_obj_t *old_obj, lv_obj_t *new_obj, PageBase *old_page, PageBase *target, Direction dir);
+    void BufferScrollStep(int32_t v);
+    static void BufferScrollExecCb(void *var, int32_t v);
+    static void BufferScrollRefrCb(lv_event_t *e);
     void OnAnimationComplete(PageBase *old_page, PageBase *new_page);
+    void TrackAnim(lv_anim_t *a);
+    void RewindHistory(bool reverse);
+    void BeginTransitionTiming();
+    uint32_t FlingDuration(int32_t velocity, int32_t remaining, int32_t span) const;
+    lv_anim_path_cb_t TransitionPath(lv_anim_path_cb_t base) const;
+    static int32_t AdaptivePath(const lv_anim_t *a, lv_anim_path_cb_t base);
+    static int32_t AdaptiveEaseOut(const lv_anim_t *a) { return AdaptivePath(a, lv_anim_path_ease_out); }
+    static int32_t AdaptiveEaseInOut(const lv_anim_t *a) { return AdaptivePath(a, lv_anim_path_ease_in_out); }
+    static void AdaptiveRefrCb(lv_event_t *e);
+    struct SnapshotLayer {
+        lv_obj_t *img = nullptr;
+        lv_obj_t *live = nullptr;
+        lv_draw_buf_t *buf = nullptr;
+    };
+    lv_obj_t *SnapshotPage(lv_obj_t *live, SnapshotLayer &layer);
+    void ReleaseSnapshot(SnapshotLayer &layer);
+    void FreeSnapshotBuffers();
     void CleanupInactivePages();
+    void DestroyCachedPage(PageBase *page);
+    void EvictPage(PageBase *page);
+    static bool PageInUseCb(const PageBase *page, void *user_data);
+    bool References(const PageBase *page) const;
+    void RestorePageState(PageBase *page);
+    uint32_t CreatePage(PageBase *page);
+    static uint32_t HeapUsed();
+    void CreateStepTick();
+    static void CreateStepTimerCb(lv_timer_t *t);
+    bool IsNeighbor(PageBase *from, PageBase *page) const;
+    void ReleasePreloaded(PageBase *new_current);
+    void SchedulePreload();
+    void PreloadStep();
+    static void PreloadTimerCb(lv_timer_t *t);
+    MemoryPressure ReadMemoryPressure() const;
+    void StartMemoryTimer();
+    static void MemoryTimerCb(lv_timer_t *t);
+    static void PointerTimerCb(lv_timer_t *t);
+    void SamplePointer();
+    int32_t PointerVelocity(Direction dir);
     void OnGestureDetected(Direction dir);
     static void GestureEventCb(lv_event_t *e);
+    static void DragEventCb(lv_event_t *e);
+    void OnDragEvent(lv_event_code_t code);
+    bool BeginDrag(Direction gesture_dir);
+    void PlaceDrag(int32_t progress);
+    void EndDrag(bool commit);
+    bool IsPreloaded(const PageBase *page) const;
     bool initialized_ = false;
     lv_obj_t *parent_ = nullptr;
     lv_obj_t *page_container_ = nullptr;
     const ui_theme_t *theme_ = nullptr;
-    PageRegistry registry_;
+    PageRegistry own_registry_;
+    PageRegistry &registry_;  /**< own_registry_ or the shared one */
+    lv_indev_t *indev_ = nullptr;
+    MpscQueue<PostedCommand, 16> mailbox_;
+    lv_timer_t *mailbox_timer_ = nullptr;
+    FrameMetrics frame_metrics_;
     PageBase *current_page_ = nullptr;
-    static constexpr int kMaxHistory = 10;
-    struct HistoryEntry {
-        std::string page_id;
-        Direction dir = Direction::Right;
+    /* Ring buffer: history_count_ entries ending just before history_head_ (newest) */
+    std::vector<HistoryEntry> history_ = std::vector<HistoryEntry>(10);
+    size_t history_head_ = 0;
+    size_t history_count_ = 0;
+    bool history_unbounded_ = false;
+    static constexpr size_t kNavQueueSize = 8;
+    NavQueuePolicy nav_queue_policy_ = NavQueuePolicy::LatestWins;
+    bool interruptible_ = false;
+    NavRequest nav_queue_[kNavQueueSize];
+    size_t nav_queue_head_ = 0;  /* oldest */
+    size_t nav_queue_count_ = 0;
+    bool gesture_enabled_ = true;
+    bool drag_tracking_ = false;
+    static constexpr int32_t kDragStartPx = 12;
+    static constexpr int32_t kFlingPxPerS = 400;  /* slower releases use the normal duration */
+    static constexpr uint32_t kFlingMinMs = 80;
+    uint32_t fling_time_ = 0;  /* duration for the next BeginTransitionTiming, 0 = transition_duration_ */
+    /* Recent (tick, point) samples of the pressed pointer, for the release speed of a gesture */
+    static constexpr size_t kPointerSamples = 8;
+    static constexpr uint32_t kVelocityWindowMs = 100;
+    struct PointerSample { uint32_t tick; lv_point_t point; };
+    PointerSample pointer_samples_[kPointerSamples] = {};
+    size_t pointer_sample_head_ = 0;   /* next slot; the newest sample is just before it */
+    size_t pointer_sample_count_ = 0;
+    lv_timer_t *pointer_timer_ = nullptr;
+    struct DragContext {
+        enum class Phase : uint8_t { Idle, Pending, Dragging } phase = Phase::Idle;
+        lv_point_t start = {0, 0};
+        PageBase *target = nullptr;
+        Direction anim_dir = Direction::Left;
         TransitionType type = TransitionType::Slide;
+        int32_t span = 0;       /* page width or height along anim_dir */
+        int32_t sign = 1;       /* +1 when the new page enters from the right/bottom */
+        int32_t progress = 0;   /* 0 .. span, along anim_dir */
+        uint32_t last_tick = 0;
+        int32_t velocity = 0;   /* px/s along anim_dir, smoothed */
     };
-    HistoryEntry history_[kMaxHistory];
-    int history_index_ = 0;
-    bool gesture_enabled_ = true;
+    DragContext drag_;
     TransitionType transition_type_ = TransitionType::Slide;
     uint32_t transition_duration_ = 300;
+    uint32_t anim_time_ = 300;
+    bool adaptive_ = false;
+    uint32_t adaptive_min_steps_ = 4;
+    uint32_t adaptive_steps_ = 0;
+    uint32_t frame_period_x16_ = LV_DEF_REFR_PERIOD * 16;
+    uint32_t last_frame_tick_ = 0;
+    bool frame_rendered_ = false;
     bool is_animating_ = false;
     int max_cached_pages_ = -1;
-    std::vector<PageBase *> inactive_cache_;
+    std::vector<PageBase *> inactive_cache_;  /**< Least recently used first */
+    uint32_t cache_budget_ = 0;
+    bool state_restore_ = false;
+    std::map<std::string, std::vector<uint8_t>> saved_states_;
+    uint32_t create_step_budget_ms_ = 4;
+    uint32_t page_arena_size_ = 0;
+    lv_timer_t *create_step_timer_ = nullptr;
+    std::vector<PageBase *> building_;
+    static constexpr uint32_t kPreloadDelayMs = 100;
+    bool preload_enabled_ = false;
+    uint32_t preload_budget_ = 0;
+    uint32_t preload_bytes_ = 0;
+    lv_timer_t *preload_timer_ = nullptr;
+    struct PreloadedPage { PageBase *page; uint32_t bytes; };
+    std::vector<PreloadedPage> preloaded_;
+    static constexpr uint32_t kMemoryCheckPeriodMs = 500;
+    uint32_t mem_low_ = 0;
+    uint32_t mem_critical_ = 0;
+    uint32_t (*system_heap_probe_)(void *) = nullptr;
+    void *system_heap_user_data_ = nullptr;
+    uint32_t sys_low_ = 0;
+    uint32_t sys_critical_ = 0;
+    MemoryPressure pressure_ = MemoryPressure::Normal;
+    lv_timer_t *memory_timer_ = nullptr;
+    SnapshotMode snapshot_mode_ = SnapshotMode::Off;
+    SnapshotLayer snap_old_;
+    SnapshotLayer snap_new_;
+    lvgl_nav_kit_scroll_shift_cb_t scroll_shift_cb_ = nullptr;
+    void *scroll_shift_user_data_ = nullptr;
+    struct ScrollContext {
+        lv_obj_t *old_obj = nullptr;
+        lv_obj_t *new_obj = nullptr;
+        Direction dir = Direction::Left;
+        int32_t span = 0;     /* new page offset at start; old page sits at offset - span */
+        int32_t last = 0;     /* offset applied in the previous step */
+        int32_t pending = 0;  /* exposed width not yet rendered */
+    };
+    ScrollContext scroll_;
     struct AnimContext {
         UIManager *mgr = nullptr;
         PageBase *old_p = nullptr;
         PageBase *new_p = nullptr;
+        bool reversed = false;  /* running back towards old_p */
+        /* Running animations, looked up with lv_anim_get, with their forward endpoints */
+        struct Track {
+            void *var = nullptr;
+            lv_anim_exec_xcb_t exec = nullptr;
+            int32_t from = 0;
+            int32_t to = 0;
+        } tracks[2];
+        HistoryEntry history_pushed;  /* what this navigation pushed, if anything */
+        size_t history_popped = 0;    /* or how many entries it popped */
+        PageBase *Leaving() const { return reversed ? new_p : old_p; }
+        PageBase *Entering() const { return reversed ? old_p : new_p; }
     };
     AnimContext anim_ctx_;
 };
@@ -6,8 +6,21 @@
 namespace ui {
 
 enum class Direction { Up, Down, Left, Right };
-enum class TransitionType { None, Slide, Fade, SlideOver };
+/** BufferScroll: Slide that shifts the pixels already on the panel and renders only the exposed strip. */
+enum class TransitionType { None, Slide, Fade, SlideOver, BufferScroll };
+constexpr int kTransitionTypeCount = 5;
+/** What Slide/SlideOver animate: live page containers, or bitmaps of them (lv_snapshot). */
+enum class SnapshotMode { Off, Outgoing, Both };
 enum class PageState { Registered, Created, Active, Inactive, Destroyed };
+/**
+ * What UIManager does with navigations requested while a transition runs:
+ * Drop ignores them; LatestWins runs only the newest once the transition ends;
+ * DropIntermediate runs the first and the newest; ExecuteAll runs every one in
+ * order, all but the last without animation.
+ */
+enum class NavQueuePolicy { Drop, LatestWins, DropIntermediate, ExecuteAll };
+/** Free heap relative to UIManager::SetMemoryWatermarks. */
+enum class MemoryPressure { Normal, Low, Critical };
 
 inline Direction GetOppositeDirection(Direction dir) {
     switch (dir) {
@@ -1,4 +1,7 @@
 #include "lvgl_nav_kit/display.h"
+#include "src/display/lv_display_private.h"
+#include <cstdlib>
+#include <cstring>
 #include <esp_log.h>
 
 #define TAG "Display"
@@ -52,3 +55,57 @@ lv_indev_t *lvgl_nav_kit_add_pointer_indev(lv_display_t *disp,
 #endif
     return indev;
 }
+
+/* An async flush (DMA) may still be reading the buffer; wait the way LVGL's refresh does */
+static void WaitForFlush(lv_display_t *disp) {
+    if (disp->flush_wait_cb) {
+        if (disp->flushing) disp->flush_wait_cb(disp);
+        disp->flushing = 0;
+    } else {
+        while (disp->flushing) {}
+    }
+}
+
+bool lvgl_nav_kit_shift_direct_buffer(lv_display_t *disp, const lv_area_t *area,
+                                      int32_t dx, int32_t dy, void *user_data) {
+    (void)user_data;
+    if (disp == nullptr || area == nullptr || disp->flush_cb == nullptr) {
+        return false;
+    }
+    /* Only a single persistent buffer holds last frame's pixels */
+    lv_draw_buf_t *buf = disp->buf_act;
+    if (disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT || disp->buf_2 != nullptr ||
+        buf == nullptr || buf->data == nullptr) {
+        return false;
+    }
+    int32_t w = area->x2 - area->x1 + 1;
+    int32_t h = area->y2 - area->y1 + 1;
+    if (abs(dx) >= w || abs(dy) >= h) {
+        return true; /* nothing survives the shift; the exposed strip covers the area */
+    }
+    uint32_t px_size = lv_color_format_get_size((lv_color_format_t)buf->header.cf);
+    uint32_t stride = buf->header.stride;
+    int32_t copy_w = w - abs(dx);
+    int32_t copy_h = h - abs(dy);
+    int32_t src_x = area->x1 + (dx < 0 ? -dx : 0);
+    int32_t dst_x = area->x1 + (dx > 0 ? dx : 0);
+    int32_t src_y = area->y1 + (dy < 0 ? -dy : 0);
+    int32_t dst_y = area->y1 + (dy > 0 ? dy : 0);
+    WaitForFlush(disp);
+    /* Walk rows against the shift direction so no source row is overwritten before it is copied */
+    for (int32_t i = 0; i < copy_h; i++) {
+        int32_t r = dy > 0 ? copy_h - 1 - i : i;
+        uint8_t *dst = buf->data + (uint32_t)(dst_y + r) * stride + (uint32_t)dst_x * px_size;
+        const uint8_t *src = buf->data + (uint32_t)(src_y + r) * stride + (uint32_t)src_x * px_size;
+        memmove(dst, src, (size_t)copy_w * px_size);
+    }
+    /* Panels with their own GRAM still show the old image: send them the moved pixels as
+       LVGL would send a DIRECT-mode area, without rendering them again */
+    lv_area_t moved = {dst_x, dst_y, dst_x + copy_w - 1, dst_y + copy_h - 1};
+    disp->flushing = 1;
+    disp->flushing_last = 1;
+    disp->flush_cb(disp, &moved, buf->data);
+    WaitForFlush(disp);
+    disp->flushing_last = 0;
+    return true;
+}
@@ -0,0 +1,172 @@
+#include "lvgl_nav_kit/frame_metrics.h"
+#include <algorithm>
+#include <chrono>
+#include <esp_log.h>
+
+#define TAG "FrameMetrics"
+
+namespace ui {
+
+static int64_t NowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static uint32_t SpanUs(int64_t from, int64_t to) {
+    return to > from ? static_cast<uint32_t>(to - from) : 0;
+}
+
+static FramePercentiles ComputePercentiles(std::vector<uint32_t> &v) {
+    FramePercentiles p;
+    if (v.empty()) return p;
+    std::sort(v.begin(), v.end());
+    p.p50 = v[(v.size() - 1) * 50 / 100];
+    p.p95 = v[(v.size() - 1) * 95 / 100];
+    p.max = v.back();
+    return p;
+}
+
+FrameMetrics::~FrameMetrics() { Disable(); }
+
+void FrameMetrics::Enable(lv_display_t *disp, size_t capacity) {
+    if (!disp || capacity == 0) {
+        ESP_LOGE(TAG, "Frame metrics need a display and a non-zero capacity");
+        return;
+    }
+    Disable();
+    ring_.assign(capacity, FrameSample());
+    Reset();
+    disp_ = disp;
+    lv_display_add_event_cb(disp_, DisplayEventCb, LV_EVENT_ALL, this);
+    ESP_LOGI(TAG, "Frame metrics enabled (%u samples)", (unsigned)capacity);
+}
+
+void FrameMetrics::Disable() {
+    if (!disp_) return;
+    lv_display_remove_event_cb_with_user_data(disp_, DisplayEventCb, this);
+    disp_ = nullptr;
+    active_ = false;
+    closing_ = false;
+    in_frame_ = false;
+}
+
+void FrameMetrics::Reset() {
+    head_ = 0;
+    count_ = 0;
+    for (auto &c : counters_) c = Counters();
+}
+
+void FrameMetrics::BeginTransition(TransitionType type) {
+    if (!disp_) return;
+    active_ = true;
+    closing_ = false;
+    type_ = type;
+    last_start_us_ = NowUs();
+    counters_[static_cast<int>(type)].transitions++;
+}
+
+void FrameMetrics::EndTransition() {
+    if (active_) closing_ = true;
+}
+
+size_t FrameMetrics::GetSamples(FrameSample *out, size_t max) const {
+    if (!out) return 0;
+    size_t n = std::min(max, count_);
+    size_t cap = ring_.size();
+    size_t first = (head_ + cap - count_) % cap;
+    for (size_t i = 0; i < n; i++) out[i] = ring_[(first + i) % cap];
+    return n;
+}
+
+FrameStats FrameMetrics::GetStats(TransitionType type) const {
+    FrameStats st;
+    const Counters &c = counters_[static_cast<int>(type)];
+    st.transitions = c.transitions;
+    st.frames = c.frames;
+    st.dropped_frames = c.dropped;
+    std::vector<uint32_t> frame, render, flush, dirty;
+    size_t cap = ring_.size();
+    for (size_t i = 0; i < count_; i++) {
+        const FrameSample &s = ring_[(head_ + cap - count_ + i) % cap];
+        if (s.type != type) continue;
+        frame.push_back(s.frame_us);
+        render.push_back(s.render_us);
+        flush.push_back(s.flush_us);
+        dirty.push_back(s.dirty_px);
+    }
+    st.frame_us = ComputePercentiles(frame);
+    st.render_us = ComputePercentiles(render);
+    st.flush_us = ComputePercentiles(flush);
+    st.dirty_px = ComputePercentiles(dirty);
+    return st;
+}
+
+void FrameMetrics::Push(const FrameSample &s) {
+    ring_[head_] = s;
+    head_ = (head_ + 1) % ring_.size();
+    if (count_ < ring_.size()) count_++;
+    Counters &c = counters_[static_cast<int>(s.type)];
+    c.frames++;
+    /* An interval of n budgets means n - 1 refresh periods went by without a frame */
+    uint32_t periods = (s.interval_us + frame_budget_us_ / 2) / frame_budget_us_;
+    if (periods > 1) c.dropped += periods - 1;
+}
+
+void FrameMetrics::DisplayEventCb(lv_event_t *e) {
+    FrameMetrics *self = (FrameMetrics *)lv_event_get_user_data(e);
+    if (self->active_) self->OnDisplayEvent(lv_event_get_code(e), e);
+}
+
+void FrameMetrics::OnDisplayEvent(lv_event_code_t code, lv_event_t *e) {
+    int64_t now = NowUs();
+    switch (code) {
+        case LV_EVENT_REFR_START:
+            cur_ = FrameSample();
+            cur_.type = type_;
+            cur_.interval_us = SpanUs(last_start_us_, now);
+            last_start_us_ = now;
+            refr_start_us_ = now;
+            in_frame_ = true;
+            break;
+        case LV_EVENT_RENDER_START:
+            render_start_us_ = now;
+            break;
+        case LV_EVENT_RENDER_READY: {
+            uint32_t span = SpanUs(render_start_us_, now);
+            cur_.render_us = span > cur_.flush_us ? span - cur_.flush_us : 0;
+            break;
+        }
+        case LV_EVENT_FLUSH_START: {
+            flush_start_us_ = now;
+            const lv_area_t *a = (const lv_area_t *)lv_event_get_param(e);
+            if (a) cur_.dirty_px += (uint32_t)(a->x2 - a->x1 + 1) * (uint32_t)(a->y2 - a->y1 + 1);
+            break;
+        }
+        case LV_EVENT_FLUSH_FINISH:
+            cur_.flush_us += SpanUs(flush_start_us_, now);
+            break;
+#if LVGL_VERSION_MAJOR > 9 || (LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 2)
+        case LV_EVENT_FLUSH_WAIT_START:
+            wait_start_us_ = now;
+            break;
+        case LV_EVENT_FLUSH_WAIT_FINISH:
+            cur_.flush_us += SpanUs(wait_start_us_, now);
+            break;
+#endif
+        case LV_EVENT_REFR_READY:
+            if (!in_frame_) break;
+            in_frame_ = false;
+            cur_.frame_us = SpanUs(refr_start_us_, now);
+            /* Refresh cycles with nothing invalidated are not frames */
+            if (cur_.dirty_px > 0) Push(cur_);
+            if (closing_) {
+                active_ = false;
+                closing_ = false;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+} // namespace ui
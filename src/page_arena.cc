@@ -0,0 +1,231 @@
+#include "lvgl_nav_kit/page_arena.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <esp_log.h>
+
+#define TAG "PageArena"
+
+#ifndef LVGL_NAV_KIT_PAGE_ARENA
+#define LVGL_NAV_KIT_PAGE_ARENA 0
+#endif
+#if LVGL_NAV_KIT_PAGE_ARENA && LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+#define PAGE_ARENA_ENABLED 1
+#else
+#define PAGE_ARENA_ENABLED 0
+#endif
+
+namespace ui {
+
+static constexpr uint32_t kClassSize[] = {16, 32, 48, 64, 96, 128, 192, 256};
+static constexpr uint32_t kSystem = 0xff;
+
+/* Precedes every block lv_malloc returns; 8 bytes keeps the payload 8-byte aligned */
+struct BlockHeader {
+    uint32_t size;  /* requested bytes */
+    uint32_t cls;   /* size class index, or kSystem for malloc'd blocks */
+};
+
+/*
+ * The allocator behind lv_malloc_core and friends. LVGL calls are serialized by the
+ * LVGL task (or its port lock), so no locking here, as with LVGL's own builtin heap.
+ */
+struct PageArenaAllocator {
+    static PageArena *arenas;  /* created, plus released ones still holding allocations */
+    static PageArena *active;
+    static uint32_t used;
+    static uint32_t max_used;
+    static uint32_t used_cnt;
+
+    static void Account(int64_t delta, int cnt) {
+        used = (uint32_t)((int64_t)used + delta);
+        used_cnt += cnt;
+        if (used > max_used) max_used = used;
+    }
+
+    static PageArena *Owner(const void *p) {
+        for (PageArena *a = arenas; a; a = a->next_) {
+            if ((const uint8_t *)p >= a->base_ && (const uint8_t *)p < a->end_) return a;
+        }
+        return nullptr;
+    }
+
+    static void Destroy(PageArena *arena) {
+        for (PageArena **link = &arenas; *link; link = &(*link)->next_) {
+            if (*link == arena) {
+                *link = arena->next_;
+                break;
+            }
+        }
+        if (active == arena) active = nullptr;
+        free(arena->base_);
+        delete arena;
+    }
+
+    static void *Alloc(size_t size) {
+        if (PageArena *a = active) {
+            size_t cls = 0;
+            while (cls < PageArena::kClassCount && kClassSize[cls] < size) cls++;
+            if (cls < PageArena::kClassCount) {
+                uint32_t block = sizeof(BlockHeader) + kClassSize[cls];
+                BlockHeader *h = (BlockHeader *)a->free_[cls];
+                if (h) {
+                    a->free_[cls] = *(void **)h;
+                } else if ((size_t)(a->end_ - a->bump_) >= block) {
+                    h = (BlockHeader *)a->bump_;
+                    a->bump_ += block;
+                }
+                if (h) {
+                    h->size = (uint32_t)size;
+                    h->cls = (uint32_t)cls;
+                    a->live_++;
+                    a->used_ += block;
+                    Account(block, 1);
+                    return h + 1;
+                }
+            }
+            a->fallbacks_++;
+        }
+        BlockHeader *h = (BlockHeader *)malloc(sizeof(BlockHeader) + size);
+        if (!h) return nullptr;
+        h->size = (uint32_t)size;
+        h->cls = kSystem;
+        Account(sizeof(BlockHeader) + size, 1);
+        return h + 1;
+    }
+
+    static void Free(void *p) {
+        if (!p) return;
+        BlockHeader *h = (BlockHeader *)p - 1;
+        if (h->cls == kSystem) {
+            Account(-(int64_t)(sizeof(BlockHeader) + h->size), -1);
+            free(h);
+            return;
+        }
+        PageArena *a = Owner(h);
+        if (!a) {
+            ESP_LOGE(TAG, "Free of unknown block %p", p);
+            return;
+        }
+        uint32_t cls = h->cls;
+        uint32_t block = sizeof(BlockHeader) + kClassSize[cls];
+        *(void **)h = a->free_[cls];
+        a->free_[cls] = h;
+        a->live_--;
+        a->used_ -= block;
+        Account(-(int64_t)block, -1);
+        if (a->released_ && a->live_ == 0) Destroy(a);
+    }
+
+    static void *Realloc(void *p, size_t size) {
+        if (!p) return Alloc(size);
+        BlockHeader *h = (BlockHeader *)p - 1;
+        if (h->cls == kSystem) {
+            uint32_t old = h->size;
+            BlockHeader *n = (BlockHeader *)realloc(h, sizeof(BlockHeader) + size);
+            if (!n) return nullptr;
+            n->size = (uint32_t)size;
+            Account((int64_t)size - old, 0);
+            return n + 1;
+        }
+        if (size <= kClassSize[h->cls]) {
+            h->size = (uint32_t)size;
+            return p;
+        }
+        void *n = Alloc(size);
+        if (!n) return nullptr;
+        memcpy(n, p, h->size);
+        Free(p);
+        return n;
+    }
+};
+
+PageArena *PageArenaAllocator::arenas = nullptr;
+PageArena *PageArenaAllocator::active = nullptr;
+uint32_t PageArenaAllocator::used = 0;
+uint32_t PageArenaAllocator::max_used = 0;
+uint32_t PageArenaAllocator::used_cnt = 0;
+
+bool PageArena::IsSupported() {
+    return PAGE_ARENA_ENABLED;
+}
+
+PageArena *PageArena::Create(uint32_t bytes) {
+    if (!IsSupported()) {
+        static bool warned = false;
+        if (!warned) ESP_LOGW(TAG, "Page arenas need LV_STDLIB_CUSTOM and LVGL_NAV_KIT_PAGE_ARENA in lv_conf.h");
+        warned = true;
+        return nullptr;
+    }
+    bytes = (bytes + 7) & ~7u;
+    PageArena *arena = new (std::nothrow) PageArena();
+    if (!arena) return nullptr;
+    arena->base_ = (uint8_t *)malloc(bytes);
+    if (!arena->base_) {
+        ESP_LOGW(TAG, "No room for a %u byte arena", (unsigned)bytes);
+        delete arena;
+        return nullptr;
+    }
+    arena->bump_ = arena->base_;
+    arena->end_ = arena->base_ + bytes;
+    arena->next_ = PageArenaAllocator::arenas;
+    PageArenaAllocator::arenas = arena;
+    return arena;
+}
+
+void PageArena::Release(PageArena *arena) {
+    if (!arena) return;
+    if (PageArenaAllocator::active == arena) PageArenaAllocator::active = nullptr;
+    arena->released_ = true;
+    if (arena->live_ == 0) {
+        PageArenaAllocator::Destroy(arena);
+        return;
+    }
+    ESP_LOGW(TAG, "%u allocations outlive their page, arena kept until they are freed", (unsigned)arena->live_);
+}
+
+uint32_t PageArena::GetHeapUsed() {
+    return PageArenaAllocator::used;
+}
+
+PageArena *PageArena::Activate(PageArena *arena) {
+    PageArena *prev = PageArenaAllocator::active;
+    PageArenaAllocator::active = arena;
+    return prev;
+}
+
+} // namespace ui
+
+#if PAGE_ARENA_ENABLED
+/* LVGL's LV_STDLIB_CUSTOM hooks: this component is the LVGL heap */
+extern "C" {
+
+void lv_mem_init(void) {}
+
+void lv_mem_deinit(void) {}
+
+lv_mem_pool_t lv_mem_add_pool(void *mem, size_t bytes) {
+    (void)mem;
+    (void)bytes;
+    return NULL;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool) { (void)pool; }
+
+void *lv_malloc_core(size_t size) { return ui::PageArenaAllocator::Alloc(size); }
+
+void *lv_realloc_core(void *p, size_t new_size) { return ui::PageArenaAllocator::Realloc(p, new_size); }
+
+void lv_free_core(void *p) { ui::PageArenaAllocator::Free(p); }
+
+void lv_mem_monitor_core(lv_mem_monitor_t *mon_p) {
+    /* There is no LVGL pool: total_size 0 tells UIManager to rely on its system heap probe */
+    memset(mon_p, 0, sizeof(*mon_p));
+    mon_p->used_cnt = ui::PageArenaAllocator::used_cnt;
+    mon_p->max_used = ui::PageArenaAllocator::max_used;
+}
+
+lv_result_t lv_mem_test_core(void) { return LV_RESULT_OK; }
+
+} // extern "C"
+#endif
@@ -1,6 +1,10 @@
 #include "lvgl_nav_kit/page_base.h"
+#include "lvgl_nav_kit/page_arena.h"
 #include "lvgl_nav_kit/ui_theme.h"
 #include <esp_log.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 #define TAG "PageBase"
 
@@ -9,6 +13,104 @@ namespace ui {
 #define T theme_
 #define TC(p) (T ? (p) : 0)
 
+/*
+ * Theme-derived styles shared by every widget the Create* helpers build, one set per theme,
+ * so a widget carries a few style references instead of its own local properties. They live
+ * as long as the program; themes are few and static.
+ */
+struct ThemeStyles {
+    const ui_theme_t *theme = nullptr;
+    ThemeStyles *next = nullptr;
+    lv_style_t text;            /* font_normal */
+    lv_style_t text_primary;    /* font_normal, color_text_primary */
+    lv_style_t text_secondary;  /* font_normal, color_text_secondary */
+    lv_style_t icon;            /* font_icon */
+    lv_style_t card;
+    lv_style_t field;           /* dropdown: font, radius, border colour, padding */
+    lv_style_t input;           /* field plus a 1 px border */
+    lv_style_t dialog;
+};
+
+static ThemeStyles *s_theme_styles = nullptr;
+
+static void BuildThemeStyles(ThemeStyles &s, const ui_theme_t *t) {
+    if (t->font_normal) {
+        lv_style_set_text_font(&s.text, t->font_normal);
+        lv_style_set_text_font(&s.text_primary, t->font_normal);
+        lv_style_set_text_font(&s.text_secondary, t->font_normal);
+        lv_style_set_text_font(&s.field, t->font_normal);
+        lv_style_set_text_font(&s.input, t->font_normal);
+    }
+    if (t->font_icon) lv_style_set_text_font(&s.icon, t->font_icon);
+    lv_style_set_text_color(&s.text_primary, lv_color_hex(t->color_text_primary));
+    lv_style_set_text_color(&s.text_secondary, lv_color_hex(t->color_text_secondary));
+
+    lv_style_set_bg_color(&s.card, lv_color_hex(t->color_bg_white));
+    lv_style_set_radius(&s.card, t->card_radius);
+    lv_style_set_border_width(&s.card, 0);
+
+    for (lv_style_t *f : {&s.field, &s.input}) {
+        lv_style_set_radius(f, t->input_radius);
+        lv_style_set_border_color(f, lv_color_hex(t->color_border));
+        lv_style_set_pad_ver(f, t->input_pad_v);
+    }
+    lv_style_set_border_width(&s.input, 1);
+
+    lv_style_set_bg_color(&s.dialog, lv_color_hex(t->color_bg_white));
+    lv_style_set_bg_opa(&s.dialog, LV_OPA_COVER);
+    lv_style_set_border_width(&s.dialog, 2);
+    lv_style_set_border_color(&s.dialog, lv_color_hex(t->color_primary));
+    lv_style_set_radius(&s.dialog, t->dialog_radius);
+    lv_style_set_shadow_width(&s.dialog, t->shadow_w);
+    lv_style_set_shadow_color(&s.dialog, lv_color_hex(t->color_bg_overlay));
+    lv_style_set_shadow_opa(&s.dialog, LV_OPA_20);
+    lv_style_set_pad_all(&s.dialog, t->pad_h);
+}
+
+#define THEME_STYLE_LIST(s) {&(s).text, &(s).text_primary, &(s).text_secondary, &(s).icon, &(s).card, &(s).field, &(s).input, &(s).dialog}
+
+static const ThemeStyles &GetThemeStyles(const ui_theme_t *theme) {
+    if (!theme) theme = ui_theme_get_default();
+    for (ThemeStyles *s = s_theme_styles; s; s = s->next) {
+        if (s->theme == theme) return *s;
+    }
+    /* Shared for the program's lifetime: keep their property arrays out of the page's arena */
+    PageArena *prev_arena = PageArena::Activate(nullptr);
+    ThemeStyles *s = new ThemeStyles();
+    s->theme = theme;
+    for (lv_style_t *st : THEME_STYLE_LIST(*s)) lv_style_init(st);
+    BuildThemeStyles(*s, theme);
+    s->next = s_theme_styles;
+    s_theme_styles = s;
+    PageArena::Activate(prev_arena);
+    return *s;
+}
+
+/* LVGL 9 creates the list with the dropdown. Only fall back to opening it when it does
+   not: opening forces a layout pass of the whole screen, once per dropdown. */
+static void StyleDropdownList(lv_obj_t *dropdown, const ui_theme_t *theme) {
+    lv_obj_t *list = lv_dropdown_get_list(dropdown);
+    if (!list) {
+        lv_dropdown_open(dropdown);
+        list = lv_dropdown_get_list(dropdown);
+        lv_dropdown_close(dropdown);
+    }
+    if (list && theme && theme->font_normal) lv_obj_add_style(list, &GetThemeStyles(theme).text, 0);
+}
+
+void PageBase::RefreshThemeStyles(const ui_theme_t *theme) {
+    if (!theme) theme = ui_theme_get_default();
+    for (ThemeStyles *s = s_theme_styles; s; s = s->next) {
+        if (s->theme != theme) continue;
+        PageArena *prev_arena = PageArena::Activate(nullptr);
+        for (lv_style_t *st : THEME_STYLE_LIST(*s)) lv_style_reset(st);
+        BuildThemeStyles(*s, theme);
+        PageArena::Activate(prev_arena);
+        for (lv_style_t *st : THEME_STYLE_LIST(*s)) lv_obj_report_style_change(st);
+        return;
+    }
+}
+
 PageBase::PageBase(const char *id) : id_(id) {}
 
 PageBase::~PageBase() {
@@ -32,26 +134,168 @@ void PageBase::DoCreate(lv_obj_t *parent, const ui_theme_t *theme) {
     lv_obj_add_flag(container_, LV_OBJ_FLAG_EVENT_BUBBLE);
     lv_obj_add_flag(container_, LV_OBJ_FLAG_GESTURE_BUBBLE);
 
+    if (batched_create_) BeginBatch();
     OnCreate(container_);
+    if (batched_create_) EndBatch();
+    create_step_ = 0;
+    create_pending_ = incremental_create_;
 
     state_ = PageState::Created;
     ESP_LOGI(TAG, "Page %s created", id_.c_str());
 }
 
+bool PageBase::DoCreateStep() {
+    if (!create_pending_ || !container_) return false;
+    if (!OnCreateStep(container_, create_step_++)) create_pending_ = false;
+    return create_pending_;
+}
+
 void PageBase::DoDestroy() {
     if (state_ == PageState::Registered || state_ == PageState::Destroyed) return;
     OnDestroy();
+    create_pending_ = false;
+    heap_bytes_ = 0;
     DeleteAllTimers();
+    batch_depth_ = 0;
+    batch_hid_ = false;
+    batch_dropdowns_.clear();
     if (container_) {
         lv_obj_delete(container_);
         container_ = nullptr;
     }
     event_bindings_.clear();
+    /* The widget tree is gone: the arena goes back to the heap as one block */
+    PageArena::Release(arena_);
+    arena_ = nullptr;
     theme_ = nullptr;
+    manager_ = nullptr;
     state_ = PageState::Destroyed;
     ESP_LOGI(TAG, "Page %s destroyed", id_.c_str());
 }
 
+/*
+ * Saved state: a version byte, then records of [u16 preorder index][u8 tag][payload]
+ * for widgets under container_ that differ from their defaults, then an optional
+ * kStateExtra record with OnSaveState's bytes. Restore skips records whose widget
+ * type no longer matches, so a changed OnCreate only loses state, never corrupts it.
+ */
+static constexpr uint8_t kStateVersion = 1;
+enum : uint8_t { kStateScroll = 1, kStateText, kStateSelected, kStateChecked, kStateValue, kStateExtra = 0xff };
+
+static void Put16(std::vector<uint8_t> &out, uint32_t v) {
+    out.push_back(v & 0xff);
+    out.push_back((v >> 8) & 0xff);
+}
+
+static void Put32(std::vector<uint8_t> &out, uint32_t v) {
+    Put16(out, v & 0xffff);
+    Put16(out, v >> 16);
+}
+
+static uint32_t Get16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+static uint32_t Get32(const uint8_t *p) { return Get16(p) | (Get16(p + 2) << 16); }
+
+static void SaveObjState(lv_obj_t *obj, uint32_t &index, std::vector<uint8_t> &out) {
+    uint32_t idx = index++;
+    if (idx > 0xffff) return;
+    auto record = [&](uint8_t tag) { Put16(out, idx); out.push_back(tag); };
+    /* Record defaults too, so a restore also undoes offsets or text that OnCreate sets */
+    int32_t sx = lv_obj_get_scroll_x(obj);
+    int32_t sy = lv_obj_get_scroll_y(obj);
+    if (sx || sy || lv_obj_get_scroll_right(obj) > 0 || lv_obj_get_scroll_bottom(obj) > 0) {
+        record(kStateScroll);
+        Put32(out, (uint32_t)sx);
+        Put32(out, (uint32_t)sy);
+    }
+    if (lv_obj_check_type(obj, &lv_textarea_class)) {
+        const char *txt = lv_textarea_get_text(obj);
+        size_t len = txt ? strlen(txt) : 0;
+        if (len > 0xffff) len = 0xffff;
+        record(kStateText);
+        Put16(out, len);
+        if (len) out.insert(out.end(), txt, txt + len);
+    } else if (lv_obj_check_type(obj, &lv_dropdown_class)) {
+        record(kStateSelected);
+        Put16(out, lv_dropdown_get_selected(obj));
+    } else if (lv_obj_check_type(obj, &lv_slider_class)) {
+        record(kStateValue);
+        Put32(out, (uint32_t)lv_slider_get_value(obj));
+    }
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_CHECKABLE)) {
+        record(kStateChecked);
+        out.push_back(lv_obj_has_state(obj, LV_STATE_CHECKED) ? 1 : 0);
+    }
+    uint32_t n = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < n; i++) SaveObjState(lv_obj_get_child(obj, i), index, out);
+}
+
+static void CollectObjs(lv_obj_t *obj, std::vector<lv_obj_t *> &objs) {
+    objs.push_back(obj);
+    uint32_t n = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < n; i++) CollectObjs(lv_obj_get_child(obj, i), objs);
+}
+
+void PageBase::SaveState(std::vector<uint8_t> &out) {
+    out.clear();
+    if (!container_) return;
+    out.push_back(kStateVersion);
+    uint32_t index = 0;
+    SaveObjState(container_, index, out);
+    std::vector<uint8_t> extra;
+    OnSaveState(extra);
+    if (!extra.empty() && extra.size() <= 0xffff) {
+        Put16(out, 0);
+        out.push_back(kStateExtra);
+        Put16(out, extra.size());
+        out.insert(out.end(), extra.begin(), extra.end());
+    }
+    if (out.size() == 1) out.clear();
+}
+
+void PageBase::RestoreState(const std::vector<uint8_t> &in) {
+    if (!container_ || in.empty() || in[0] != kStateVersion) return;
+    std::vector<lv_obj_t *> objs;
+    CollectObjs(container_, objs);
+    /* Scroll offsets need final sizes */
+    lv_obj_update_layout(container_);
+    const uint8_t *p = in.data() + 1;
+    const uint8_t *end = in.data() + in.size();
+    while (end - p >= 3) {
+        uint32_t idx = Get16(p);
+        uint8_t tag = p[2];
+        p += 3;
+        lv_obj_t *obj = idx < objs.size() ? objs[idx] : nullptr;
+        if (tag == kStateScroll && end - p >= 8) {
+            if (obj) lv_obj_scroll_to(obj, (int32_t)Get32(p), (int32_t)Get32(p + 4), LV_ANIM_OFF);
+            p += 8;
+        } else if ((tag == kStateText || tag == kStateExtra) && end - p >= 2 && (size_t)(end - p - 2) >= Get16(p)) {
+            uint32_t len = Get16(p);
+            if (tag == kStateExtra) {
+                OnRestoreState(p + 2, len);
+            } else if (obj && lv_obj_check_type(obj, &lv_textarea_class)) {
+                std::string txt((const char *)p + 2, len);
+                lv_textarea_set_text(obj, txt.c_str());
+            }
+            p += 2 + len;
+        } else if (tag == kStateSelected && end - p >= 2) {
+            if (obj && lv_obj_check_type(obj, &lv_dropdown_class)) lv_dropdown_set_selected(obj, Get16(p));
+            p += 2;
+        } else if (tag == kStateValue && end - p >= 4) {
+            if (obj && lv_obj_check_type(obj, &lv_slider_class)) lv_slider_set_value(obj, (int32_t)Get32(p), LV_ANIM_OFF);
+            p += 4;
+        } else if (tag == kStateChecked && end - p >= 1) {
+            if (obj && lv_obj_has_flag(obj, LV_OBJ_FLAG_CHECKABLE)) {
+                if (*p) lv_obj_add_state(obj, LV_STATE_CHECKED);
+                else lv_obj_remove_state(obj, LV_STATE_CHECKED);
+            }
+            p += 1;
+        } else {
+            ESP_LOGW(TAG, "Page %s: truncated saved state", id_.c_str());
+            return;
+        }
+    }
+}
+
 lv_timer_t *PageBase::CreateTimer(lv_timer_cb_t cb, uint32_t period, void *user_data) {
     lv_timer_t *t = lv_timer_create(cb, period, user_data);
     if (t) {
@@ -81,6 +325,29 @@ void PageBase::DoEnter() {
     OnEnter();
 }
 
+void PageBase::BeginBatch() {
+    if (!container_ || batch_depth_++ > 0) return;
+    /* Hidden objects skip invalidation: one area for the whole batch instead of one per change */
+    batch_hid_ = !lv_obj_has_flag(container_, LV_OBJ_FLAG_HIDDEN);
+    if (batch_hid_) lv_obj_add_flag(container_, LV_OBJ_FLAG_HIDDEN);
+}
+
+void PageBase::EndBatch() {
+    if (!container_) return;
+    if (batch_depth_ == 0) {
+        ESP_LOGW(TAG, "EndBatch without BeginBatch on page %s", id_.c_str());
+        return;
+    }
+    if (--batch_depth_ > 0) return;
+    lv_obj_update_layout(container_);
+    for (lv_obj_t *dropdown : batch_dropdowns_) {
+        if (lv_obj_is_valid(dropdown)) StyleDropdownList(dropdown, T);
+    }
+    batch_dropdowns_.clear();
+    if (batch_hid_) lv_obj_clear_flag(container_, LV_OBJ_FLAG_HIDDEN);
+    batch_hid_ = false;
+}
+
 void PageBase::DoLeave() {
     OnLeave();
     PauseAllTimers();
@@ -94,7 +361,7 @@ void PageBase::AddEventHandler(lv_obj_t *obj, lv_event_cb_t cb, lv_event_code_t
 lv_obj_t *PageBase::CreateLabel(lv_obj_t *parent, const char *text) {
     lv_obj_t *label = lv_label_create(parent);
     lv_label_set_text(label, text);
-    if (T && T->font_normal) lv_obj_set_style_text_font(label, T->font_normal, 0);
+    if (T && T->font_normal) lv_obj_add_style(label, &GetThemeStyles(T).text, 0);
     return label;
 }
 
@@ -102,7 +369,7 @@ lv_obj_t *PageBase::CreateButton(lv_obj_t *parent, const char *text, lv_event_cb
     lv_obj_t *btn = lv_button_create(parent);
     lv_obj_t *lab = lv_label_create(btn);
     lv_label_set_text(lab, text);
-    if (T && T->font_normal) lv_obj_set_style_text_font(lab, T->font_normal, 0);
+    if (T && T->font_normal) lv_obj_add_style(lab, &GetThemeStyles(T).text, 0);
     lv_obj_center(lab);
     if (cb) AddEventHandler(btn, cb, LV_EVENT_CLICKED, user_data);
     return btn;
@@ -111,7 +378,7 @@ lv_obj_t *PageBase::CreateButton(lv_obj_t *parent, const char *text, lv_event_cb
 lv_obj_t *PageBase::CreateCheckbox(lv_obj_t *parent, const char *text, lv_event_cb_t cb, void *user_data) {
     lv_obj_t *cb_obj = lv_checkbox_create(parent);
     lv_checkbox_set_text(cb_obj, text);
-    if (T && T->font_normal) lv_obj_set_style_text_font(cb_obj, T->font_normal, 0);
+    if (T && T->font_normal) lv_obj_add_style(cb_obj, &GetThemeStyles(T).text, 0);
     if (cb) AddEventHandler(cb_obj, cb, LV_EVENT_VALUE_CHANGED, user_data);
     return cb_obj;
 }
@@ -120,7 +387,7 @@ lv_obj_t *PageBase::CreateTextarea(lv_obj_t *parent, const char *placeholder) {
     lv_obj_t *ta = lv_textarea_create(parent);
     lv_textarea_set_placeholder_text(ta, placeholder);
     lv_textarea_set_one_line(ta, true);
-    if (T && T->font_normal) lv_obj_set_style_text_font(ta, T->font_normal, 0);
+    if (T && T->font_normal) lv_obj_add_style(ta, &GetThemeStyles(T).text, 0);
     return ta;
 }
 
@@ -128,9 +395,7 @@ lv_obj_t *PageBase::CreateCard(lv_obj_t *parent, int x, int y, int w, int h) {
     lv_obj_t *card = lv_obj_create(parent);
     lv_obj_set_pos(card, x, y);
     lv_obj_set_size(card, w, h);
-    lv_obj_set_style_bg_color(card, lv_color_hex(TC(T->color_bg_white)), 0);
-    lv_obj_set_style_radius(card, TC(T->card_radius), 0);
-    lv_obj_set_style_border_width(card, 0, 0);
+    lv_obj_add_style(card, &GetThemeStyles(T).card, 0);
     lv_obj_set_scrollbar_mode(card, LV_SCROLLBAR_MODE_OFF);
     lv_obj_clear_flag(card, LV_OBJ_FLAG_SCROLLABLE);
     return card;
@@ -147,17 +412,10 @@ lv_obj_t *PageBase::CreateDropdown(lv_obj_t *parent, const char *options, lv_eve
     lv_obj_t *dropdown = lv_dropdown_create(parent);
     lv_dropdown_set_options(dropdown, options);
     lv_obj_set_size(dropdown, TC(T->dropdown_w), TC(T->input_h));
-    if (T && T->font_normal) lv_obj_set_style_text_font(dropdown, T->font_normal, 0);
-    lv_obj_set_style_radius(dropdown, TC(T->input_radius), 0);
-    lv_obj_set_style_border_color(dropdown, lv_color_hex(TC(T->color_border)), 0);
-    lv_obj_set_style_pad_ver(dropdown, TC(T->input_pad_v), 0);
-    /* Open/close to access the list widget and apply font. This is the
-       standard LVGL workaround; no visual flash occurs because LVGL batches
-       rendering and the page container is hidden during creation. */
-    lv_dropdown_open(dropdown);
-    lv_obj_t *list = lv_dropdown_get_list(dropdown);
-    if (list && T && T->font_normal) lv_obj_set_style_text_font(list, T->font_normal, 0);
-    lv_dropdown_close(dropdown);
+    lv_obj_add_style(dropdown, &GetThemeStyles(T).field, 0);
+    /* Inside a batch the open/close workaround, which forces a layout pass, waits for EndBatch */
+    if (!lv_dropdown_get_list(dropdown) && batch_depth_) batch_dropdowns_.push_back(dropdown);
+    else StyleDropdownList(dropdown, T);
     if (cb) lv_obj_add_event_cb(dropdown, cb, LV_EVENT_VALUE_CHANGED, user_data);
     return dropdown;
 }
@@ -169,12 +427,8 @@ lv_obj_t *PageBase::CreateSmallInput(lv_obj_t *parent, const char *placeholder,
     lv_textarea_set_placeholder_text(ta, placeholder);
     lv_textarea_set_max_length(ta, max_len);
     lv_obj_set_size(ta, TC(T->input_w_sm), TC(T->input_h));
-    if (T && T->font_normal) lv_obj_set_style_text_font(ta, T->font_normal, 0);
+    lv_obj_add_style(ta, &GetThemeStyles(T).input, 0);
     lv_obj_set_style_text_align(ta, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_style_border_width(ta, 1, 0);
-    lv_obj_set_style_border_color(ta, lv_color_hex(TC(T->color_border)), 0);
-    lv_obj_set_style_radius(ta, TC(T->input_radius), 0);
-    lv_obj_set_style_pad_ver(ta, TC(T->input_pad_v), 0);
     if (cb) lv_obj_add_event_cb(ta, cb, LV_EVENT_ALL, user_data);
     return ta;
 }
@@ -187,11 +441,7 @@ lv_obj_t *PageBase::CreateFlexInput(lv_obj_t *parent, const char *placeholder, i
     lv_textarea_set_max_length(ta, max_len);
     lv_obj_set_flex_grow(ta, 1);
     lv_obj_set_height(ta, TC(T->input_h));
-    if (T && T->font_normal) lv_obj_set_style_text_font(ta, T->font_normal, 0);
-    lv_obj_set_style_border_width(ta, 1, 0);
-    lv_obj_set_style_border_color(ta, lv_color_hex(TC(T->color_border)), 0);
-    lv_obj_set_style_radius(ta, TC(T->input_radius), 0);
-    lv_obj_set_style_pad_ver(ta, TC(T->input_pad_v), 0);
+    lv_obj_add_style(ta, &GetThemeStyles(T).input, 0);
     if (cb) lv_obj_add_event_cb(ta, cb, LV_EVENT_ALL, user_data);
     return ta;
 }
@@ -199,13 +449,13 @@ lv_obj_t *PageBase::CreateFlexInput(lv_obj_t *parent, const char *placeholder, i
 lv_obj_t *PageBase::CreateIconLabel(lv_obj_t *parent, const char *icon, const char *text, uint32_t icon_color) {
     lv_obj_t *icon_lab = lv_label_create(parent);
     lv_label_set_text(icon_lab, icon);
-    if (T && T->font_icon) lv_obj_set_style_text_font(icon_lab, T->font_icon, 0);
+    const ThemeStyles &styles = GetThemeStyles(T);
+    lv_obj_add_style(icon_lab, &styles.icon, 0);
     lv_obj_set_style_text_color(icon_lab, lv_color_hex(icon_color), 0);
     lv_obj_align(icon_lab, LV_ALIGN_LEFT_MID, 0, 0);
     lv_obj_t *text_lab = lv_label_create(parent);
     lv_label_set_text(text_lab, text);
-    if (T && T->font_normal) lv_obj_set_style_text_font(text_lab, T->font_normal, 0);
-    lv_obj_set_style_text_color(text_lab, lv_color_hex(TC(T->color_text_primary)), 0);
+    lv_obj_add_style(text_lab, &styles.text_primary, 0);
     lv_obj_align(text_lab, LV_ALIGN_LEFT_MID, TC(T->icon_offset), 0);
     return text_lab;
 }
@@ -229,19 +479,14 @@ lv_obj_t *PageBase::CreateKeyboard(lv_obj_t *parent, lv_keyboard_mode_t mode) {
 }
 
 lv_obj_t *PageBase::CreateDialog(int w, int h, uint32_t border_color) {
-    uint32_t bc = border_color ? border_color : (T ? T->color_primary : 0x2196F3);
-    lv_obj_t *dlg = lv_obj_create(lv_layer_top());
+    lv_obj_t *dlg = lv_obj_create(lv_display_get_layer_top(GetDisplay()));
     lv_obj_set_size(dlg, w, h);
     lv_obj_center(dlg);
-    lv_obj_set_style_bg_color(dlg, lv_color_hex(T ? T->color_bg_white : 0xFFFFFF), 0);
-    lv_obj_set_style_bg_opa(dlg, LV_OPA_COVER, 0);
-    lv_obj_set_style_border_width(dlg, 2, 0);
-    lv_obj_set_style_border_color(dlg, lv_color_hex(bc), 0);
-    lv_obj_set_style_radius(dlg, TC(T->dialog_radius), 0);
-    lv_obj_set_style_shadow_width(dlg, TC(T->shadow_w), 0);
-    lv_obj_set_style_shadow_color(dlg, lv_color_hex(TC(T->color_bg_overlay)), 0);
-    lv_obj_set_style_shadow_opa(dlg, LV_OPA_20, 0);
-    lv_obj_set_style_pad_all(dlg, TC(T->pad_h), 0);
+    const ThemeStyles &styles = GetThemeStyles(T);
+    lv_obj_add_style(dlg, &styles.dialog, 0);
+    if (border_color && border_color != styles.theme->color_primary) {
+        lv_obj_set_style_border_color(dlg, lv_color_hex(border_color), 0);
+    }
     lv_obj_set_scrollbar_mode(dlg, LV_SCROLLBAR_MODE_OFF);
     return dlg;
 }
@@ -251,26 +496,148 @@ void PageBase::CreateInfoRow(lv_obj_t *parent, int y, const char *icon, const ch
     int io = T ? T->icon_offset : 24;
     int lw = T ? T->label_w : 60;
     lv_obj_t *icon_l = lv_label_create(parent);
+    const ThemeStyles &styles = GetThemeStyles(T);
     lv_label_set_text(icon_l, icon);
-    if (T && T->font_icon) lv_obj_set_style_text_font(icon_l, T->font_icon, 0);
+    lv_obj_add_style(icon_l, &styles.icon, 0);
     lv_obj_set_style_text_color(icon_l, lv_color_hex(color), 0);
     lv_obj_set_pos(icon_l, 0, y + g / 2);
     lv_obj_t *title_l = lv_label_create(parent);
     lv_label_set_text(title_l, title);
-    if (T && T->font_normal) lv_obj_set_style_text_font(title_l, T->font_normal, 0);
-    lv_obj_set_style_text_color(title_l, lv_color_hex(TC(T->color_text_secondary)), 0);
+    lv_obj_add_style(title_l, &styles.text_secondary, 0);
     lv_obj_set_pos(title_l, io, y);
     *value_label = lv_label_create(parent);
     lv_label_set_text(*value_label, value);
-    if (T && T->font_normal) lv_obj_set_style_text_font(*value_label, T->font_normal, 0);
-    lv_obj_set_style_text_color(*value_label, lv_color_hex(TC(T->color_text_primary)), 0);
+    lv_obj_add_style(*value_label, &styles.text_primary, 0);
     lv_obj_set_pos(*value_label, lw + io, y);
 }
 
+/* Rows are a ring: item i always lives in rows[i % rows.size()], so scrolling by one row rebinds one row */
+struct VirtualList {
+    lv_obj_t *list = nullptr;
+    lv_obj_t *spacer = nullptr;  /* transparent, count * row_h tall: gives the list its scroll range */
+    uint32_t count = 0;
+    int32_t row_h = 1;
+    void (*bind)(lv_obj_t *row, uint32_t index, void *user_data) = nullptr;
+    void *user_data = nullptr;
+    struct Row {
+        lv_obj_t *obj;
+        int64_t index;  /* -1 = unbound */
+    };
+    std::vector<Row> rows;
+
+    void Layout(bool rebind) {
+        size_t n = rows.size();
+        int64_t first = std::max<int64_t>(0, lv_obj_get_scroll_y(list) / row_h - kOverscan);
+        for (int64_t i = first; i < first + (int64_t)n; i++) {
+            Row &r = rows[i % n];
+            if (i >= count) {
+                if (r.index >= 0) lv_obj_add_flag(r.obj, LV_OBJ_FLAG_HIDDEN);
+                r.index = -1;
+                continue;
+            }
+            if (r.index == i && !rebind) continue;
+            if (r.index < 0) lv_obj_clear_flag(r.obj, LV_OBJ_FLAG_HIDDEN);
+            r.index = i;
+            lv_obj_set_y(r.obj, (int32_t)(i * row_h));
+            lv_obj_set_user_data(r.obj, (void *)(intptr_t)i);
+            bind(r.obj, (uint32_t)i, user_data);
+        }
+    }
+
+    void SetCount(uint32_t n) {
+        /* Coordinates beyond LV_COORD_MAX collide with LVGL's special values (LV_PCT, LV_SIZE_CONTENT):
+           cap the count with the spacer so no row is placed past the scroll range */
+        uint32_t max_count = (uint32_t)(LV_COORD_MAX / row_h);
+        if (n > max_count) {
+            ESP_LOGW(TAG, "Virtual list of %u rows capped at %u", (unsigned)n, (unsigned)max_count);
+            n = max_count;
+        }
+        count = n;
+        int32_t total = (int32_t)((int64_t)n * row_h);
+        lv_obj_set_height(spacer, total);
+        /* Shrunk below the scroll position: pull back to the new end (the list was laid out
+           already if it has been scrolled) */
+        int32_t y = lv_obj_get_scroll_y(list);
+        int32_t max_y = std::max<int32_t>(0, total - lv_obj_get_content_height(list));
+        if (y > max_y) lv_obj_scroll_to_y(list, max_y, LV_ANIM_OFF);
+        Layout(true);
+    }
+
+    /* The state hangs off the list's event callback, leaving the object's user_data to the app */
+    static VirtualList *Find(lv_obj_t *list) {
+        uint32_t cnt = lv_obj_get_event_count(list);
+        for (uint32_t i = 0; i < cnt; i++) {
+            lv_event_dsc_t *dsc = lv_obj_get_event_dsc(list, i);
+            if (lv_event_dsc_get_cb(dsc) == EventCb) return (VirtualList *)lv_event_dsc_get_user_data(dsc);
+        }
+        return nullptr;
+    }
+
+    static void EventCb(lv_event_t *e) {
+        VirtualList *v = (VirtualList *)lv_event_get_user_data(e);
+        if (lv_event_get_code(e) == LV_EVENT_SCROLL) v->Layout(false);
+        else if (lv_event_get_code(e) == LV_EVENT_DELETE) delete v;
+    }
+
+    static constexpr int32_t kOverscan = 2;
+};
+
+lv_obj_t *PageBase::CreateVirtualList(lv_obj_t *parent, uint32_t item_count, int32_t row_height,
+                                      VirtualRowCreateCb create_row, VirtualRowBindCb bind_row, void *user_data) {
+    if (!bind_row || row_height <= 0) {
+        ESP_LOGE(TAG, "Virtual list needs a bind callback and a row height");
+        return nullptr;
+    }
+    lv_obj_t *list = lv_obj_create(parent);
+    lv_obj_set_size(list, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_pad_all(list, 0, 0);
+    lv_obj_set_style_border_width(list, 0, 0);
+    lv_obj_set_style_bg_opa(list, LV_OPA_TRANSP, 0);
+    lv_obj_set_scroll_dir(list, LV_DIR_VER);
+
+    VirtualList *v = new VirtualList();
+    v->list = list;
+    v->row_h = row_height;
+    v->bind = bind_row;
+    v->user_data = user_data;
+    v->spacer = lv_obj_create(list);
+    lv_obj_remove_style_all(v->spacer);
+    lv_obj_clear_flag(v->spacer, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_width(v->spacer, 1);
+
+    /* The list is never taller than the screen, so this many rows cover any scroll position */
+    size_t n = (size_t)((ScreenHeight() + row_height - 1) / row_height + 1 + 2 * VirtualList::kOverscan);
+    v->rows.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        lv_obj_t *row = lv_obj_create(list);
+        lv_obj_remove_style_all(row);
+        lv_obj_set_size(row, LV_PCT(100), row_height);
+        lv_obj_clear_flag(row, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_clear_flag(row, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_flag(row, LV_OBJ_FLAG_EVENT_BUBBLE);
+        lv_obj_add_flag(row, LV_OBJ_FLAG_HIDDEN);
+        if (create_row) create_row(row, user_data);
+        v->rows.push_back({row, -1});
+    }
+    lv_obj_add_event_cb(list, VirtualList::EventCb, LV_EVENT_SCROLL, v);
+    lv_obj_add_event_cb(list, VirtualList::EventCb, LV_EVENT_DELETE, v);
+    v->SetCount(item_count);
+    return list;
+}
+
+void PageBase::SetVirtualListCount(lv_obj_t *list, uint32_t item_count) {
+    VirtualList *v = list ? VirtualList::Find(list) : nullptr;
+    if (!v) {
+        ESP_LOGE(TAG, "SetVirtualListCount on an object that is not a virtual list");
+        return;
+    }
+    v->SetCount(item_count);
+}
+
 void PageBase::ShowLoading(const char *text) {
     if (loading_overlay_) return;
     const bool large = IsLargeScreen();
-    loading_overlay_ = lv_obj_create(lv_layer_top());
+    loading_overlay_ = lv_obj_create(lv_display_get_layer_top(GetDisplay()));
     lv_obj_set_size(loading_overlay_, LV_PCT(100), LV_PCT(100));
     lv_obj_set_pos(loading_overlay_, 0, 0);
     lv_obj_set_style_bg_color(loading_overlay_, lv_color_hex(0x000000), 0);
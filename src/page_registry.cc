@@ -1,4 +1,6 @@
 #include "lvgl_nav_kit/page_registry.h"
+#include <algorithm>
+#include <cstring>
 #include <esp_log.h>
 
 #define TAG "PageRegistry"
@@ -8,58 +10,264 @@ namespace ui {
 PageRegistry::PageRegistry() {}
 PageRegistry::~PageRegistry() { Clear(); }
 
+uint32_t PageRegistry::HashId(const char *id) {
+    uint32_t h = 2166136261u;
+    while (*id) {
+        h ^= (uint8_t)*id++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+size_t PageRegistry::FindSlot(const char *id, uint32_t hash) const {
+    size_t mask = slots_.size() - 1;
+    size_t i = hash & mask;
+    while (slots_[i].id) {
+        if (slots_[i].hash == hash && strcmp(slots_[i].id, id) == 0) break;
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+void PageRegistry::Grow() {
+    std::vector<Slot> old;
+    old.swap(slots_);
+    slots_.resize(old.empty() ? 16 : old.size() * 2);
+    for (const Slot &s : old) {
+        if (s.id) slots_[FindSlot(s.id, s.hash)] = s;
+    }
+}
+
+void PageRegistry::Resolve(PageNavigation &nav) {
+    for (NavTarget *t : {&nav.left, &nav.right, &nav.up, &nav.down}) {
+        t->target = t->page ? Find(t->page) : nullptr;
+    }
+}
+
 void PageRegistry::RegisterPage(PageBase *page) {
     if (!page) {
         ESP_LOGE(TAG, "Cannot register null page");
         return;
     }
-    auto it = id_map_.find(page->GetId());
-    if (it != id_map_.end()) {
+    if ((count_ + 1) * 2 > slots_.size()) Grow();
+    page->id_hash_ = HashId(page->GetId());
+    Slot &slot = slots_[FindSlot(page->GetId(), page->id_hash_)];
+    if (slot.id) {
         ESP_LOGW(TAG, "Page ID '%s' already exists, replacing", page->GetId());
-        delete it->second;
+        delete slot.page;
+    } else {
+        count_++;
     }
-    id_map_[page->GetId()] = page;
+    slot.hash = page->id_hash_;
+    slot.id = page->GetId();
+    slot.page = page;
+    slot.factory = nullptr;
+    Attach(page);
     ESP_LOGI(TAG, "Registered page '%s'", page->GetId());
 }
 
+void PageRegistry::RegisterPage(const char *id, PageFactory factory) {
+    if (!id || !factory) {
+        ESP_LOGE(TAG, "Cannot register page without id and factory");
+        return;
+    }
+    if ((count_ + 1) * 2 > slots_.size()) Grow();
+    uint32_t hash = HashId(id);
+    Slot &slot = slots_[FindSlot(id, hash)];
+    if (slot.id) {
+        ESP_LOGW(TAG, "Page ID '%s' already exists, replacing", id);
+        if (slot.page) {
+            if (slot.page->graph_index_ >= 0) graph_pages_[slot.page->graph_index_] = nullptr;
+            delete slot.page;
+            slot.page = nullptr;
+            for (NavEntry &e : navs_) Resolve(e.nav);
+        }
+    } else {
+        count_++;
+    }
+    slot.hash = hash;
+    slot.id = id;
+    slot.factory = factory;
+    ESP_LOGI(TAG, "Registered page '%s' (lazy)", id);
+}
+
+void PageRegistry::Attach(PageBase *page) {
+    page->nav_index_ = -1;
+    for (size_t i = 0; i < navs_.size(); i++) {
+        if (navs_[i].page_id == page->GetId()) page->nav_index_ = (int)i;
+    }
+    page->graph_index_ = -1;
+    for (size_t i = 0; i < graph_pages_.size(); i++) {
+        if (strcmp(graph_ids_[i], page->GetId()) == 0) {
+            graph_pages_[i] = page;
+            page->graph_index_ = (int)i;
+        }
+    }
+    /* Registration and loading are rare: re-resolve every edge that may point at this id */
+    for (NavEntry &e : navs_) Resolve(e.nav);
+}
+
+PageBase *PageRegistry::Load(Slot &slot) {
+    PageBase *page = slot.factory(slot.id);
+    if (!page) {
+        ESP_LOGE(TAG, "Factory for '%s' returned no page", slot.id);
+        return nullptr;
+    }
+    if (page->id_ != slot.id) {
+        ESP_LOGW(TAG, "Page '%s' registered as '%s', renaming", page->GetId(), slot.id);
+        page->id_ = slot.id;
+    }
+    page->id_hash_ = slot.hash;
+    slot.page = page;
+    Attach(page);
+    ESP_LOGI(TAG, "Loaded page '%s'", slot.id);
+    return page;
+}
+
+bool PageRegistry::Unload(PageBase *page) {
+    if (!page || slots_.empty()) return false;
+    Slot &slot = slots_[FindSlot(page->GetId(), page->id_hash_)];
+    if (slot.page != page || !slot.factory) return false;
+    if (page->GetState() != PageState::Registered && page->GetState() != PageState::Destroyed) return false;
+    for (const InUse &u : in_use_) {
+        if (u.check(page, u.user_data)) return false;
+    }
+    slot.page = nullptr;
+    if (page->graph_index_ >= 0) graph_pages_[page->graph_index_] = nullptr;
+    for (NavEntry &e : navs_) Resolve(e.nav);
+    ESP_LOGI(TAG, "Unloaded page '%s'", slot.id);
+    delete page;
+    return true;
+}
+
+void PageRegistry::AddInUseCheck(InUseCheck check, void *user_data) {
+    if (check) in_use_.push_back({check, user_data});
+}
+
+void PageRegistry::RemoveInUseCheck(void *user_data) {
+    in_use_.erase(std::remove_if(in_use_.begin(), in_use_.end(),
+                                 [user_data](const InUse &u) { return u.user_data == user_data; }),
+                  in_use_.end());
+}
+
 PageBase *PageRegistry::GetPage(const char *id) {
-    auto it = id_map_.find(id);
-    return it != id_map_.end() ? it->second : nullptr;
+    if (!id || slots_.empty()) return nullptr;
+    Slot &slot = slots_[FindSlot(id, HashId(id))];
+    if (!slot.page && slot.factory) return Load(slot);
+    return slot.page;
+}
+
+PageBase *PageRegistry::Find(const char *id) const {
+    if (!id || slots_.empty()) return nullptr;
+    return slots_[FindSlot(id, HashId(id))].page;
+}
+
+bool PageRegistry::IsLoaded(const char *id) const {
+    return Find(id) != nullptr;
 }
 
 void PageRegistry::SetNavigation(const char *page_id, const PageNavigation &nav) {
-    navigation_map_[page_id] = nav;
+    PageBase *page = Find(page_id);
+    int index = page ? page->nav_index_ : -1;
+    if (index < 0) {
+        for (size_t i = 0; i < navs_.size(); i++) {
+            if (navs_[i].page_id == page_id) index = (int)i;
+        }
+    }
+    if (index < 0) {
+        index = (int)navs_.size();
+        navs_.push_back({page_id, nav});
+    } else {
+        navs_[index].nav = nav;
+    }
+    Resolve(navs_[index].nav);
+    if (page) page->nav_index_ = index;
     ESP_LOGI(TAG, "Set navigation for '%s'", page_id);
 }
 
+const PageNavigation *PageRegistry::GetNavigation(const char *page_id) const {
+    if (!page_id) return nullptr;
+    if (const PageBase *page = Find(page_id)) return GetNavigation(page);
+    for (const NavEntry &e : navs_) {
+        if (e.page_id == page_id) return &e.nav;
+    }
+    return nullptr;
+}
+
+const PageNavigation *PageRegistry::GetNavigation(const PageBase *page) const {
+    if (!page || page->nav_index_ < 0) return nullptr;
+    return &navs_[page->nav_index_].nav;
+}
+
 bool PageRegistry::GetNavigationTarget(const char *page_id, Direction gesture_dir, PageBase *&out_target, Direction &out_anim_dir, TransitionType &out_anim_type) {
-    auto it = navigation_map_.find(page_id);
-    if (it == navigation_map_.end()) {
+    return GetNavigationTarget(GetPage(page_id), gesture_dir, out_target, out_anim_dir, out_anim_type);
+}
+
+void PageRegistry::SetNavigationGraph(const char *const *ids, const StaticNavNode *nodes, size_t count) {
+    for (Slot &s : slots_) {
+        if (s.page) s.page->graph_index_ = -1;
+    }
+    graph_ids_ = ids;
+    graph_nodes_ = nodes;
+    graph_pages_.assign(count, nullptr);
+    for (size_t i = 0; i < count; i++) {
+        PageBase *page = Find(ids[i]);
+        graph_pages_[i] = page;
+        if (page) page->graph_index_ = (int)i;
+    }
+    ESP_LOGI(TAG, "Set navigation graph with %u pages", (unsigned)count);
+}
+
+PageBase *PageRegistry::GetNeighbor(const PageBase *page, Direction gesture_dir) {
+    PageBase *target = nullptr;
+    Direction anim_dir;
+    TransitionType anim_type;
+    GetNavigationTarget(page, gesture_dir, target, anim_dir, anim_type);
+    return target;
+}
+
+bool PageRegistry::GetNavigationTarget(const PageBase *page, Direction gesture_dir, PageBase *&out_target, Direction &out_anim_dir, TransitionType &out_anim_type) {
+    if (page && page->graph_index_ >= 0) {
+        const StaticNavNode &node = graph_nodes_[page->graph_index_];
+        int d = (int)gesture_dir;
+        int t = node.target[d];
+        out_target = t < 0 ? nullptr : graph_pages_[t] ? graph_pages_[t] : GetPage(graph_ids_[t]);
+        out_anim_dir = node.anim_dir[d];
+        out_anim_type = node.anim_type[d];
+        return out_target != nullptr;
+    }
+    const PageNavigation *nav = GetNavigation(page);
+    if (!nav) {
         out_target = nullptr;
         return false;
     }
-    const PageNavigation &nav = it->second;
     const NavTarget *target = nullptr;
     switch (gesture_dir) {
-        case Direction::Left:  target = &nav.left;  break;
-        case Direction::Right: target = &nav.right; break;
-        case Direction::Up:    target = &nav.up;    break;
-        case Direction::Down:  target = &nav.down;  break;
+        case Direction::Left:  target = &nav->left;  break;
+        case Direction::Right: target = &nav->right; break;
+        case Direction::Up:    target = &nav->up;    break;
+        case Direction::Down:  target = &nav->down;  break;
     }
-    if (!target || !target->page) {
+    /* Loading a factory page resolves every edge to it, this one included */
+    if (target && !target->target && target->page) GetPage(target->page);
+    if (!target || !target->target) {
         out_target = nullptr;
         return false;
     }
-    out_target = GetPage(target->page);
+    out_target = target->target;
     out_anim_dir = target->anim_dir;
     out_anim_type = target->anim_type;
-    return out_target != nullptr;
+    return true;
 }
 
 void PageRegistry::Clear() {
-    for (auto &pair : id_map_) delete pair.second;
-    id_map_.clear();
-    navigation_map_.clear();
+    for (Slot &s : slots_) delete s.page;
+    slots_.clear();
+    count_ = 0;
+    navs_.clear();
+    graph_ids_ = nullptr;
+    graph_nodes_ = nullptr;
+    graph_pages_.clear();
 }
 
 } // namespace ui
@@ -1,6 +1,10 @@
 #include "lvgl_nav_kit/ui_manager.h"
+#include "lvgl_nav_kit/page_arena.h"
 #include "lvgl_nav_kit/ui_theme.h"
 #include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <esp_log.h>
 
 #define TAG "UIManager"
@@ -12,8 +16,20 @@ UIManager &UIManager::GetInstance() {
     return instance;
 }
 
-UIManager::UIManager() {}
-UIManager::~UIManager() { Shutdown(); }
+UIManager::UIManager(PageRegistry *shared_registry)
+    : registry_(shared_registry ? *shared_registry : own_registry_) {
+    registry_.AddInUseCheck(PageInUseCb, this);
+}
+
+UIManager::~UIManager() {
+    Shutdown();
+    registry_.RemoveInUseCheck(this);
+}
+
+void UIManager::Initialize(lv_display_t *disp, const ui_theme_t *theme) {
+    if (!disp) { ESP_LOGE(TAG, "No display"); return; }
+    Initialize(lv_display_get_screen_active(disp), theme);
+}
 
 void UIManager::Initialize(lv_obj_t *parent, const ui_theme_t *theme) {
     if (initialized_) {
@@ -36,25 +52,86 @@ void UIManager::Initialize(lv_obj_t *parent, const ui_theme_t *theme) {
     lv_obj_add_flag(page_container_, LV_OBJ_FLAG_GESTURE_BUBBLE);
 
     lv_obj_add_event_cb(parent_, GestureEventCb, LV_EVENT_GESTURE, this);
+    if (drag_tracking_) lv_obj_add_event_cb(page_container_, DragEventCb, LV_EVENT_ALL, this);
+    if (adaptive_) {
+        lv_display_add_event_cb(lv_obj_get_display(page_container_), AdaptiveRefrCb, LV_EVENT_ALL, this);
+    }
 
     initialized_ = true;
+    StartMemoryTimer();
+    mailbox_timer_ = lv_timer_create(MailboxTimerCb, LV_DEF_REFR_PERIOD, this);
+    pointer_timer_ = lv_timer_create(PointerTimerCb, LV_DEF_REFR_PERIOD, this);
     ESP_LOGI(TAG, "UI Manager initialized");
 }
 
 void UIManager::Shutdown() {
     if (!initialized_) return;
+    drag_ = DragContext();
+    if (is_animating_) {
+        /* Stop the transition where it is. BufferScroll animates this manager, not a page,
+           so deleting the pages below would leave it stepping freed objects. */
+        for (const AnimContext::Track &t : anim_ctx_.tracks) {
+            if (t.var) lv_anim_delete(t.var, t.exec);
+        }
+        lv_anim_delete(this, BufferScrollExecCb);
+        lv_display_remove_event_cb_with_user_data(lv_obj_get_display(page_container_), BufferScrollRefrCb, this);
+        PageBase *other = anim_ctx_.old_p == current_page_ ? anim_ctx_.new_p : anim_ctx_.old_p;
+        if (other && &registry_ != &own_registry_) other->DoDestroy();
+        scroll_ = ScrollContext();
+        anim_ctx_ = AnimContext();
+        is_animating_ = false;
+    }
     if (current_page_) {
         current_page_->DoLeave();
         current_page_->DoDestroy();
         current_page_ = nullptr;
     }
+    if (&registry_ != &own_registry_) {
+        /* Shared registry: destroy what this display created, the pages stay registered */
+        for (PageBase *p : inactive_cache_) p->DoDestroy();
+        for (const PreloadedPage &p : preloaded_) p.page->DoDestroy();
+    }
+    if (preload_timer_) {
+        lv_timer_delete(preload_timer_);
+        preload_timer_ = nullptr;
+    }
+    preloaded_.clear();
+    preload_bytes_ = 0;
+    if (create_step_timer_) {
+        lv_timer_delete(create_step_timer_);
+        create_step_timer_ = nullptr;
+    }
+    building_.clear();
+    if (memory_timer_) {
+        lv_timer_delete(memory_timer_);
+        memory_timer_ = nullptr;
+    }
+    if (mailbox_timer_) {
+        lv_timer_delete(mailbox_timer_);
+        mailbox_timer_ = nullptr;
+    }
+    /* Commands posted for this session must not run against the next Initialize */
+    PostedCommand stale;
+    while (mailbox_.Pop(stale)) {}
+    if (pointer_timer_) {
+        lv_timer_delete(pointer_timer_);
+        pointer_timer_ = nullptr;
+    }
+    pointer_sample_count_ = 0;
+    pressure_ = MemoryPressure::Normal;
+    frame_metrics_.Disable();
+    lv_display_remove_event_cb_with_user_data(lv_obj_get_display(page_container_), AdaptiveRefrCb, this);
+    ReleaseSnapshot(snap_old_);
+    ReleaseSnapshot(snap_new_);
+    FreeSnapshotBuffers();
     inactive_cache_.clear();
-    registry_.Clear();
+    if (&registry_ == &own_registry_) registry_.Clear();
     if (page_container_) {
         lv_obj_delete(page_container_);
         page_container_ = nullptr;
     }
-    history_index_ = 0;
+    history_count_ = 0;
+    nav_queue_count_ = 0;
     theme_ = nullptr;
     initialized_ = false;
     ESP_LOGI(TAG, "UI Manager shutdown");
@@ -64,6 +141,7 @@ void UIManager::NavigateTo(const char *page_id, Direction dir, TransitionType ty
     if (!initialized_) { ESP_LOGE(TAG, "UI Manager not initialized"); return; }
     PageBase *target = registry_.GetPage(page_id);
     if (!target) { ESP_LOGW(TAG, "Page '%s' not found", page_id); return; }
+    if (QueueIfBusy({NavRequest::Kind::To, target, dir, type})) return;
     DoNavigate(target, dir, type);
 }
 
@@ -72,38 +150,302 @@ void UIManager::NavigateToWithFade(const char *page_id) {
 }
 
 void UIManager::NavigateBack() {
-    if (history_index_ > 0) {
-        history_index_--;
-        const HistoryEntry &entry = history_[history_index_];
-        PageBase *target = registry_.GetPage(entry.page_id.c_str());
-        if (target) {
-            DoNavigate(target, GetOppositeDirection(entry.dir), entry.type, false);
+    if (QueueIfBusy({NavRequest::Kind::Back})) return;
+    GoBack(1);
+}
+
+void UIManager::NavigateBackTo(const char *page_id) {
+    PageBase *target = registry_.GetPage(page_id);
+    if (target && QueueIfBusy({NavRequest::Kind::BackTo, target})) return;
+    if (!BackToPage(target, true)) ESP_LOGW(TAG, "Page '%s' not in history", page_id);
+}
+
+void UIManager::PopToRoot() {
+    if (QueueIfBusy({NavRequest::Kind::Root})) return;
+    GoBack(history_count_);
+}
+
+void UIManager::ReplaceCurrent(const char *page_id, Direction dir, TransitionType type) {
+    if (!initialized_) { ESP_LOGE(TAG, "UI Manager not initialized"); return; }
+    PageBase *target = registry_.GetPage(page_id);
+    if (!target) { ESP_LOGW(TAG, "Page '%s' not found", page_id); return; }
+    if (QueueIfBusy({NavRequest::Kind::Replace, target, dir, type})) return;
+    DoNavigate(target, dir, type, false);
+}
+
+bool UIManager::PostNavigate(const char *page_id, Direction dir, TransitionType type) {
+    PostedCommand cmd;
+    cmd.kind = PostedCommand::Kind::Navigate;
+    cmd.dir = dir;
+    cmd.type = type;
+    return Post(cmd, page_id);
+}
+
+bool UIManager::PostBack() {
+    PostedCommand cmd;
+    cmd.kind = PostedCommand::Kind::Back;
+    return Post(cmd, nullptr);
+}
+
+bool UIManager::PostBackTo(const char *page_id) {
+    PostedCommand cmd;
+    cmd.kind = PostedCommand::Kind::BackTo;
+    return Post(cmd, page_id);
+}
+
+bool UIManager::PostToPage(const char *page_id, uint32_t message, void *data) {
+    PostedCommand cmd;
+    cmd.kind = PostedCommand::Kind::Message;
+    cmd.message = message;
+    cmd.data = data;
+    return Post(cmd, page_id);
+}
+
+bool UIManager::Post(PostedCommand &cmd, const char *page_id) {
+    /* Runs on the caller's task: touch nothing but the mailbox */
+    if (page_id) {
+        size_t len = strnlen(page_id, kPostedIdLen);
+        if (len == kPostedIdLen) return false;
+        memcpy(cmd.page_id, page_id, len + 1);
+    }
+    return mailbox_.Push(cmd);
+}
+
+void UIManager::MailboxTimerCb(lv_timer_t *t) {
+    UIManager *self = (UIManager *)lv_timer_get_user_data(t);
+    self->DrainMailbox();
+}
+
+void UIManager::DrainMailbox() {
+    /* Commands posted while draining wait for the next tick, so a busy producer cannot stall rendering */
+    PostedCommand cmd;
+    for (size_t n = 0; n < decltype(mailbox_)::Capacity() && mailbox_.Pop(cmd); n++) {
+        switch (cmd.kind) {
+            case PostedCommand::Kind::Navigate: NavigateTo(cmd.page_id, cmd.dir, cmd.type); break;
+            case PostedCommand::Kind::Back:     NavigateBack(); break;
+            case PostedCommand::Kind::BackTo:   NavigateBackTo(cmd.page_id); break;
+            case PostedCommand::Kind::Message: {
+                PageBase *page = registry_.GetPage(cmd.page_id);
+                if (page) page->OnMessage(cmd.message, cmd.data);
+                else ESP_LOGW(TAG, "Message %u for unknown page '%s'", (unsigned)cmd.message, cmd.page_id);
+                break;
+            }
         }
     }
 }
 
+bool UIManager::BackToPage(PageBase *target, bool animate) {
+    for (size_t i = 0; target && i < history_count_; i++) {
+        if (HistoryFromTop(i).page == target) {
+            GoBack(i + 1, animate);
+            return true;
+        }
+    }
+    return false;
+}
+
+void UIManager::GoBack(size_t entries, bool animate) {
+    if (entries == 0 || entries > history_count_ || is_animating_) return;
+    /* The animation mirrors the forward step out of the entry we land on */
+    HistoryEntry entry = HistoryFromTop(entries - 1);
+    if (!entry.page || entry.page == current_page_) {
+        ESP_LOGW(TAG, "Back target '%s' is already shown", entry.page ? entry.page->GetId() : "none");
+        return;
+    }
+    /* Pop first so the pages left behind are no longer referenced when DoNavigate cleans up */
+    size_t size = history_.size();
+    history_count_ -= entries;
+    history_head_ = (history_head_ + size - entries % size) % size;
+    TransitionType type = animate ? entry.type : TransitionType::None;
+    DoNavigate(entry.page, GetOppositeDirection(entry.dir), type, false);
+    if (is_animating_) {
+        anim_ctx_.history_popped = entries;
+    } else if (current_page_ != entry.page) {
+        /* Navigation did not start (the page is held elsewhere): the entries are still in the ring */
+        history_count_ += entries;
+        history_head_ = (history_head_ + entries) % size;
+    }
+}
+
+void UIManager::SetNavQueuePolicy(NavQueuePolicy policy) {
+    nav_queue_policy_ = policy;
+    if (policy == NavQueuePolicy::Drop) nav_queue_count_ = 0;
+}
+
+bool UIManager::QueueIfBusy(const NavRequest &req) {
+    if (!is_animating_) return false;
+    if (req.Targets(anim_ctx_.Entering())) return true;
+    if (interruptible_) {
+        PageBase *leaving = anim_ctx_.Leaving();
+        bool back = req.kind == NavRequest::Kind::Back && history_count_ && HistoryFromTop(0).page == leaving;
+        bool to_leaving = (req.kind == NavRequest::Kind::To || req.kind == NavRequest::Kind::BackTo) && req.page == leaving;
+        if (back || to_leaving) {
+            ReverseTransition();
+            return true;
+        }
+        FinishTransition();
+    }
+    switch (nav_queue_policy_) {
+        case NavQueuePolicy::Drop:
+            ESP_LOGW(TAG, "Transition running, navigation dropped");
+            return true;
+        case NavQueuePolicy::LatestWins:
+            nav_queue_count_ = 0;
+            break;
+        case NavQueuePolicy::DropIntermediate:
+            /* Keep the first pending request, replace whatever came after it */
+            if (nav_queue_count_ >= 2) nav_queue_count_ = 1;
+            break;
+        case NavQueuePolicy::ExecuteAll:
+            if (nav_queue_count_ == kNavQueueSize) {
+                ESP_LOGW(TAG, "Navigation queue full, oldest request dropped");
+                nav_queue_head_ = (nav_queue_head_ + 1) % kNavQueueSize;
+                nav_queue_count_--;
+            }
+            break;
+    }
+    nav_queue_[(nav_queue_head_ + nav_queue_count_) % kNavQueueSize] = req;
+    nav_queue_count_++;
+    return true;
+}
+
+void UIManager::RunNavRequest(const NavRequest &req, bool animate) {
+    TransitionType type = animate ? req.type : TransitionType::None;
+    switch (req.kind) {
+        case NavRequest::Kind::To:      DoNavigate(req.page, req.dir, type); break;
+        case NavRequest::Kind::Replace: DoNavigate(req.page, req.dir, type, false); break;
+        case NavRequest::Kind::Back:    GoBack(1, animate); break;
+        case NavRequest::Kind::BackTo:  BackToPage(req.page, animate); break;
+        case NavRequest::Kind::Root:    GoBack(history_count_, animate); break;
+    }
+}
+
+void UIManager::DrainNavQueue() {
+    while (nav_queue_count_ && !is_animating_) {
+        NavRequest req = nav_queue_[nav_queue_head_];
+        nav_queue_head_ = (nav_queue_head_ + 1) % kNavQueueSize;
+        nav_queue_count_--;
+        if (req.Targets(current_page_)) continue;
+        bool animate = nav_queue_policy_ != NavQueuePolicy::ExecuteAll || nav_queue_count_ == 0;
+        RunNavRequest(req, animate);
+    }
+}
+
+void UIManager::SetHistoryDepth(size_t depth) {
+    history_unbounded_ = depth == 0;
+    size_t cap = depth ? depth : std::max<size_t>(history_count_, 16);
+    if (cap == history_.size()) return;
+    /* Re-linearize, keeping the newest entries */
+    size_t keep = std::min(history_count_, cap);
+    std::vector<HistoryEntry> ring(cap);
+    for (size_t i = 0; i < keep; i++) ring[keep - 1 - i] = HistoryFromTop(i);
+    history_.swap(ring);
+    history_count_ = keep;
+    history_head_ = keep % cap;
+}
+
+void UIManager::PushHistory(const HistoryEntry &entry) {
+    if (history_count_ == history_.size()) {
+        if (history_unbounded_) {
+            SetHistoryDepth(history_.size() * 2);
+            history_unbounded_ = true;
+        } else {
+            /* Overwrite the oldest entry */
+            history_count_--;
+            ESP_LOGW(TAG, "Navigation history full, oldest entry dropped");
+        }
+    }
+    history_[history_head_] = entry;
+    history_head_ = (history_head_ + 1) % history_.size();
+    history_count_++;
+}
+
 void UIManager::SetTransitionType(TransitionType type) { transition_type_ = type; }
 void UIManager::SetTransitionDuration(uint32_t ms) { transition_duration_ = ms; }
 void UIManager::EnableGesture(bool enable) { gesture_enabled_ = enable; }
+
+void UIManager::EnableDragTracking(bool enable) {
+    if (enable == drag_tracking_) return;
+    drag_tracking_ = enable;
+    if (!initialized_) return;
+    if (enable) {
+        lv_obj_add_event_cb(page_container_, DragEventCb, LV_EVENT_ALL, this);
+    } else {
+        lv_obj_remove_event_cb_with_user_data(page_container_, DragEventCb, this);
+        if (drag_.phase == DragContext::Phase::Dragging) EndDrag(false);
+        drag_.phase = DragContext::Phase::Idle;
+    }
+}
 void UIManager::SetMaxCachedPages(int n) { max_cached_pages_ = n; }
 
+void UIManager::SetCacheBudget(uint32_t bytes) {
+    cache_budget_ = bytes;
+    if (initialized_ && !is_animating_) CleanupInactivePages();
+}
+
+void UIManager::EnableStateRestore(bool enable) {
+    state_restore_ = enable;
+    if (!enable) saved_states_.clear();
+}
+
+void UIManager::ClearSavedState(const char *page_id) {
+    if (page_id) saved_states_.erase(page_id);
+    else saved_states_.clear();
+}
+
+uint32_t UIManager::GetCachedBytes() const {
+    uint32_t total = 0;
+    for (PageBase *p : inactive_cache_) total += p->GetHeapFootprint();
+    return total;
+}
+
+void UIManager::SetSnapshotMode(SnapshotMode mode) {
+#if !LV_USE_SNAPSHOT
+    if (mode != SnapshotMode::Off) ESP_LOGW(TAG, "LV_USE_SNAPSHOT is disabled, slides stay live");
+#endif
+    snapshot_mode_ = mode;
+    if (mode == SnapshotMode::Off && !is_animating_) FreeSnapshotBuffers();
+}
+
+void UIManager::EnablePreload(bool enable, uint32_t budget_bytes) {
+    preload_enabled_ = enable;
+    preload_budget_ = budget_bytes;
+    if (enable) SchedulePreload();
+    else if (preload_timer_) lv_timer_pause(preload_timer_);
+}
+
+void UIManager::SetAdaptiveTransitions(bool enable, uint32_t min_steps) {
+    adaptive_min_steps_ = min_steps ? min_steps : 1;
+    if (enable == adaptive_) return;
+    adaptive_ = enable;
+    if (!initialized_) return;
+    lv_display_t *disp = lv_obj_get_display(page_container_);
+    if (enable) lv_display_add_event_cb(disp, AdaptiveRefrCb, LV_EVENT_ALL, this);
+    else lv_display_remove_event_cb_with_user_data(disp, AdaptiveRefrCb, this);
+}
+
+void UIManager::SetScrollShiftCallback(lvgl_nav_kit_scroll_shift_cb_t cb, void *user_data) {
+    scroll_shift_cb_ = cb;
+    scroll_shift_user_data_ = user_data;
+}
+
+void UIManager::EnableFrameMetrics(bool enable, size_t capacity) {
+    if (!enable) { frame_metrics_.Disable(); return; }
+    if (!initialized_) { ESP_LOGE(TAG, "UI Manager not initialized"); return; }
+    frame_metrics_.Enable(lv_obj_get_display(page_container_), capacity);
+}
+
 void UIManager::DoNavigate(PageBase *target, Direction dir, TransitionType type, bool record_history) {
-    if (!target || is_animating_) return;
+    if (!target || is_animating_ || target == current_page_) return;
+    if (!ClaimPage(target)) return;
 
     ESP_LOGI(TAG, "Navigating from '%s' to '%s' (dir: %s, type: %d)",
              current_page_ ? current_page_->GetId() : "none", target->GetId(), DirectionToString(dir), (int)type);
 
+    HistoryEntry pushed;
     if (record_history && current_page_) {
-        if (history_index_ >= kMaxHistory) {
-            /* Shift history, drop oldest entry */
-            for (int i = 0; i < kMaxHistory - 1; i++) {
-                history_[i] = std::move(history_[i + 1]);
-            }
-            history_index_ = kMaxHistory - 1;
-            ESP_LOGW(TAG, "Navigation history full, oldest entry dropped");
-        }
-        history_[history_index_] = {current_page_->GetId(), dir, type};
-        history_index_++;
+        pushed = {current_page_, dir, type};
+        PushHistory(pushed);
     }
 
     PageBase *old_page = current_page_;
@@ -111,9 +453,11 @@ void UIManager::DoNavigate(PageBase *target, Direction dir, TransitionType type,
     /* Remove target from inactive cache if it was cached */
     auto cache_it = std::find(inactive_cache_.begin(), inactive_cache_.end(), target);
     if (cache_it != inactive_cache_.end()) inactive_cache_.erase(cache_it);
+    if (preload_timer_) lv_timer_pause(preload_timer_);
+    ReleasePreloaded(target);
 
     if (target->GetState() == PageState::Registered || target->GetState() == PageState::Destroyed) {
-        target->DoCreate(page_container_, theme_);
+        CreatePage(target);
     }
 
     if (target->GetContainer()) {
@@ -132,45 +476,568 @@ void UIManager::DoNavigate(PageBase *target, Direction dir, TransitionType type,
         target->DoEnter();
         current_page_ = target;
         CleanupInactivePages();
+        SchedulePreload();
     } else if (type == TransitionType::Fade) {
         DoFadeTransition(old_page->GetContainer(), target->GetContainer(), old_page, target);
         current_page_ = target;
     } else if (type == TransitionType::SlideOver) {
         DoSlideOverTransition(old_page->GetContainer(), target->GetContainer(), old_page, target, dir);
         current_page_ = target;
+    } else if (type == TransitionType::BufferScroll) {
+        DoBufferScrollTransition(old_page->GetContainer(), target->GetContainer(), old_page, target, dir);
+        current_page_ = target;
     } else {
         DoSlideTransition(old_page->GetContainer(), target->GetContainer(), old_page, target, dir);
         current_page_ = target;
     }
+    if (is_animating_) anim_ctx_.history_pushed = pushed;
 }
 
 void UIManager::OnAnimationComplete(PageBase *old_page, PageBase *new_page) {
-    if (old_page) {
-        old_page->DoLeave();
-        old_page->state_ = PageState::Inactive;
-        if (old_page->GetContainer()) {
-            lv_obj_add_flag(old_page->GetContainer(), LV_OBJ_FLAG_HIDDEN);
+    /* A sibling animation may not have applied its last frame yet: snap it and stop it */
+    for (const AnimContext::Track &t : anim_ctx_.tracks) {
+        lv_anim_t *a = t.var ? lv_anim_get(t.var, t.exec) : nullptr;
+        if (!a) continue;
+        a->exec_cb(a->var, a->end_value);
+        lv_anim_delete(t.var, t.exec);
+    }
+    ReleaseSnapshot(snap_old_);
+    ReleaseSnapshot(snap_new_);
+    if (anim_ctx_.reversed) {
+        /* Reversed: new_page was never entered and old_page never left */
+        if (new_page->GetContainer()) {
+            lv_obj_add_flag(new_page->GetContainer(), LV_OBJ_FLAG_HIDDEN);
+            lv_obj_set_pos(new_page->GetContainer(), 0, 0);
+            lv_obj_set_style_opa(new_page->GetContainer(), LV_OPA_COVER, 0);
         }
-        inactive_cache_.push_back(old_page);
+        new_page->state_ = PageState::Inactive;
+        if (!IsPreloaded(new_page)) inactive_cache_.push_back(new_page);
+        old_page->state_ = PageState::Active;
+    } else {
+        if (old_page) {
+            old_page->DoLeave();
+            old_page->state_ = PageState::Inactive;
+            if (old_page->GetContainer()) {
+                lv_obj_add_flag(old_page->GetContainer(), LV_OBJ_FLAG_HIDDEN);
+            }
+            inactive_cache_.push_back(old_page);
+        }
+        new_page->state_ = PageState::Active;
+        new_page->DoEnter();
     }
-    new_page->state_ = PageState::Active;
-    new_page->DoEnter();
+    anim_ctx_ = AnimContext();
     is_animating_ = false;
+    frame_metrics_.EndTransition();
     CleanupInactivePages();
+    SchedulePreload();
+    DrainNavQueue();
+}
+
+void UIManager::TrackAnim(lv_anim_t *a) {
+    if (!a) return;
+    for (AnimContext::Track &t : anim_ctx_.tracks) {
+        if (t.var) continue;
+        t = {a->var, a->exec_cb, a->start_value, a->end_value};
+        return;
+    }
+}
+
+void UIManager::FinishTransition() {
+    if (!is_animating_) return;
+    for (const AnimContext::Track &t : anim_ctx_.tracks) {
+        lv_anim_t *a = t.var ? lv_anim_get(t.var, t.exec) : nullptr;
+        if (a) a->act_time = a->duration;
+    }
+}
+
+bool UIManager::ReverseTransition() {
+    if (!is_animating_ || !anim_ctx_.old_p) return false;
+    anim_ctx_.reversed = !anim_ctx_.reversed;
+    uint32_t duration = 1;
+    for (const AnimContext::Track &t : anim_ctx_.tracks) {
+        lv_anim_t *a = t.var ? lv_anim_get(t.var, t.exec) : nullptr;
+        if (!a) continue;
+        /* From where it is now, over the share of the full duration that distance takes */
+        int32_t target = anim_ctx_.reversed ? t.from : t.to;
+        int64_t span = std::abs((int64_t)t.to - t.from);
+        int64_t left = std::abs((int64_t)target - a->current_value);
+        duration = span ? (uint32_t)std::max<int64_t>(1, anim_time_ * left / span) : 1;
+        lv_anim_set_values(a, a->current_value, target);
+        lv_anim_set_time(a, duration);
+        a->act_time = 0;
+    }
+    if (adaptive_ && adaptive_steps_ > 1) {
+        adaptive_steps_ = std::max<uint32_t>(1, duration / std::max<uint32_t>(1, GetMeasuredFramePeriod()));
+    }
+    RewindHistory(anim_ctx_.reversed);
+    current_page_ = anim_ctx_.reversed ? anim_ctx_.old_p : anim_ctx_.new_p;
+    ESP_LOGI(TAG, "Transition reversed towards '%s'", current_page_->GetId());
+    return true;
+}
+
+void UIManager::RewindHistory(bool reverse) {
+    const AnimContext &c = anim_ctx_;
+    size_t size = history_.size();
+    if (c.history_pushed.page) {
+        if (!reverse) {
+            PushHistory(c.history_pushed);
+        } else if (history_count_) {
+            history_count_--;
+            history_head_ = (history_head_ + size - 1) % size;
+        }
+    } else if (c.history_popped) {
+        /* Popped entries stay in the ring until something is pushed, and nothing was */
+        size_t n = c.history_popped;
+        if (reverse) {
+            history_count_ += n;
+            history_head_ = (history_head_ + n) % size;
+        } else {
+            history_count_ -= n;
+            history_head_ = (history_head_ + size - n % size) % size;
+        }
+    }
 }
 
 void UIManager::CleanupInactivePages() {
-    if (max_cached_pages_ < 0) return;
-    while (static_cast<int>(inactive_cache_.size()) > max_cached_pages_) {
+    if (max_cached_pages_ >= 0) {
+        while (static_cast<int>(inactive_cache_.size()) > max_cached_pages_) {
+            PageBase *p = inactive_cache_.front();
+            inactive_cache_.erase(inactive_cache_.begin());
+            ESP_LOGI(TAG, "Destroying cached page '%s'", p->GetId());
+            EvictPage(p);
+        }
+    }
+    if (!cache_budget_) return;
+    uint32_t total = GetCachedBytes();
+    while (total > cache_budget_ && !inactive_cache_.empty()) {
+        /* Rank 1 is the most recently left page; a large, long-unused page scores highest */
+        size_t victim = 0;
+        uint64_t best = 0;
+        for (size_t i = 0; i < inactive_cache_.size(); i++) {
+            uint64_t rank = inactive_cache_.size() - i;
+            uint64_t score = (uint64_t)inactive_cache_[i]->GetHeapFootprint() * rank;
+            if (score > best) {
+                best = score;
+                victim = i;
+            }
+        }
+        PageBase *p = inactive_cache_[victim];
+        inactive_cache_.erase(inactive_cache_.begin() + victim);
+        total -= std::min(total, p->GetHeapFootprint());
+        ESP_LOGI(TAG, "Destroying cached page '%s' (%u bytes)", p->GetId(), (unsigned)p->GetHeapFootprint());
+        EvictPage(p);
+    }
+}
+
+void UIManager::SetMemoryWatermarks(uint32_t low_bytes, uint32_t critical_bytes) {
+    mem_low_ = std::max(low_bytes, critical_bytes);
+    mem_critical_ = critical_bytes;
+    StartMemoryTimer();
+}
+
+void UIManager::SetSystemHeapProbe(uint32_t (*probe)(void *user_data), void *user_data, uint32_t low_bytes,
+                                   uint32_t critical_bytes) {
+    system_heap_probe_ = probe;
+    system_heap_user_data_ = user_data;
+    sys_low_ = std::max(low_bytes, critical_bytes);
+    sys_critical_ = critical_bytes;
+    StartMemoryTimer();
+}
+
+void UIManager::StartMemoryTimer() {
+    bool watching = mem_low_ || (system_heap_probe_ && sys_low_);
+    if (!initialized_ || !watching) {
+        if (memory_timer_) lv_timer_pause(memory_timer_);
+        return;
+    }
+    if (!memory_timer_) memory_timer_ = lv_timer_create(MemoryTimerCb, kMemoryCheckPeriodMs, this);
+    lv_timer_resume(memory_timer_);
+}
+
+void UIManager::MemoryTimerCb(lv_timer_t *t) {
+    UIManager *self = (UIManager *)lv_timer_get_user_data(t);
+    self->CheckMemoryPressure();
+}
+
+static MemoryPressure ClassifyFree(uint32_t free_bytes, uint32_t low, uint32_t critical) {
+    if (critical && free_bytes < critical) return MemoryPressure::Critical;
+    if (low && free_bytes < low) return MemoryPressure::Low;
+    return MemoryPressure::Normal;
+}
+
+MemoryPressure UIManager::ReadMemoryPressure() const {
+    MemoryPressure level = MemoryPressure::Normal;
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    /* total_size is 0 when LVGL uses an external allocator; only the system probe applies then */
+    if (mon.total_size) level = ClassifyFree(mon.free_size, mem_low_, mem_critical_);
+    if (system_heap_probe_) {
+        uint32_t free_bytes = system_heap_probe_(system_heap_user_data_);
+        level = std::max(level, ClassifyFree(free_bytes, sys_low_, sys_critical_));
+    }
+    return level;
+}
+
+MemoryPressure UIManager::CheckMemoryPressure() {
+    if (!initialized_) return MemoryPressure::Normal;
+    MemoryPressure level = ReadMemoryPressure();
+    if (level == MemoryPressure::Normal) {
+        pressure_ = level;
+        return level;
+    }
+    /* Preloads are speculative: they go to the cache and are shed with it */
+    ReleasePreloaded(nullptr);
+    MemoryPressure now = level;
+    while (!inactive_cache_.empty() && (level == MemoryPressure::Critical || now != MemoryPressure::Normal)) {
         PageBase *p = inactive_cache_.front();
         inactive_cache_.erase(inactive_cache_.begin());
-        ESP_LOGI(TAG, "Destroying cached page '%s'", p->GetId());
-        p->DoDestroy();
+        ESP_LOGW(TAG, "Low memory, destroying cached page '%s'", p->GetId());
+        EvictPage(p);
+        now = ReadMemoryPressure();
+    }
+    if (now != MemoryPressure::Normal && !is_animating_) FreeSnapshotBuffers();
+    now = ReadMemoryPressure();
+    if (now > pressure_) {
+        ESP_LOGW(TAG, "Memory pressure %s", now == MemoryPressure::Critical ? "critical" : "low");
+        if (current_page_) current_page_->OnLowMemory(now);
+        if (is_animating_ && anim_ctx_.old_p) anim_ctx_.old_p->OnLowMemory(now);
+        for (PageBase *p : inactive_cache_) p->OnLowMemory(now);
+    }
+    pressure_ = now;
+    return level;
+}
+
+void UIManager::EvictPage(PageBase *page) {
+    auto build_it = std::find(building_.begin(), building_.end(), page);
+    if (build_it != building_.end()) building_.erase(build_it);
+    DestroyCachedPage(page);
+    /* Factory pages give back the C++ object too, unless history or the queue still names them */
+    registry_.Unload(page);
+}
+
+bool UIManager::PageInUseCb(const PageBase *page, void *user_data) {
+    return ((const UIManager *)user_data)->References(page);
+}
+
+bool UIManager::References(const PageBase *page) const {
+    if (HoldsPage(page)) return true;
+    size_t size = history_.size();
+    for (size_t i = 0; i < history_count_; i++) {
+        if (history_[(history_head_ + size - 1 - i) % size].page == page) return true;
+    }
+    if (is_animating_) {
+        /* What the running transition pushed or popped comes back if it is reversed */
+        if (anim_ctx_.history_pushed.page == page) return true;
+        for (size_t i = 0; i < anim_ctx_.history_popped; i++) {
+            if (history_[(history_head_ + i) % size].page == page) return true;
+        }
+    }
+    for (size_t i = 0; i < nav_queue_count_; i++) {
+        if (nav_queue_[(nav_queue_head_ + i) % kNavQueueSize].page == page) return true;
+    }
+    for (const PreloadedPage &p : preloaded_) {
+        if (p.page == page) return true;
+    }
+    return std::find(building_.begin(), building_.end(), page) != building_.end();
+}
+
+void UIManager::DestroyCachedPage(PageBase *page) {
+    /* A half-built page would overwrite a saved blob with a partial tree; keep the old one */
+    if (state_restore_ && page->IsCreateComplete()) {
+        std::vector<uint8_t> blob;
+        page->SaveState(blob);
+        if (blob.empty()) saved_states_.erase(page->GetId());
+        else saved_states_[page->GetId()] = std::move(blob);
+    }
+    page->DoDestroy();
+}
+
+void UIManager::RestorePageState(PageBase *page) {
+    if (saved_states_.empty()) return;
+    auto it = saved_states_.find(page->GetId());
+    if (it == saved_states_.end()) return;
+    page->RestoreState(it->second);
+    saved_states_.erase(it);
+}
+
+uint32_t UIManager::HeapUsed() {
+    /* The arena allocator tracks its own usage; other non-builtin allocators report zeros
+       and every page measures 0 */
+    if (PageArena::IsSupported()) return PageArena::GetHeapUsed();
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+bool UIManager::ClaimPage(PageBase *page) {
+    UIManager *owner = page->manager_;
+    if (!owner || owner == this) return true;
+    /* Shared registry: a page is on one display at a time; only a cached one can move */
+    if (owner->HoldsPage(page)) {
+        ESP_LOGW(TAG, "Page '%s' is in use on another display", page->GetId());
+        return false;
+    }
+    owner->ReleasePage(page);
+    return true;
+}
+
+bool UIManager::HoldsPage(const PageBase *page) const {
+    if (page == current_page_) return true;
+    if (drag_.phase == DragContext::Phase::Dragging && page == drag_.target) return true;
+    return is_animating_ && (page == anim_ctx_.old_p || page == anim_ctx_.new_p);
+}
+
+void UIManager::ReleasePage(PageBase *page) {
+    auto cache_it = std::find(inactive_cache_.begin(), inactive_cache_.end(), page);
+    if (cache_it != inactive_cache_.end()) inactive_cache_.erase(cache_it);
+    for (auto it = preloaded_.begin(); it != preloaded_.end(); ++it) {
+        if (it->page != page) continue;
+        preload_bytes_ -= std::min(preload_bytes_, it->bytes);
+        preloaded_.erase(it);
+        break;
+    }
+    auto build_it = std::find(building_.begin(), building_.end(), page);
+    if (build_it != building_.end()) building_.erase(build_it);
+    ESP_LOGI(TAG, "Handing page '%s' to another display", page->GetId());
+    DestroyCachedPage(page);
+}
+
+uint32_t UIManager::CreatePage(PageBase *page) {
+    /* Make room before a large OnCreate rather than letting it fail half way */
+    if (memory_timer_) CheckMemoryPressure();
+    uint32_t arena_bytes = page->arena_size_ ? page->arena_size_ : page_arena_size_;
+    if (arena_bytes && !page->arena_) page->arena_ = PageArena::Create(arena_bytes);
+    PageArena *prev_arena = PageArena::Activate(page->arena_);
+    uint32_t before = HeapUsed();
+    /* OnCreate may already call GetManager(), e.g. to post or query the theme */
+    page->manager_ = this;
+    page->DoCreate(page_container_, theme_);
+    uint32_t after = HeapUsed();
+    page->heap_bytes_ = after > before ? after - before : 0;
+    /* An incremental page is restored once, when its last step has run: the blob indexes
+       the complete widget tree */
+    if (page->IsCreateComplete()) RestorePageState(page);
+    PageArena::Activate(prev_arena);
+    if (!page->IsCreateComplete()) {
+        building_.push_back(page);
+        if (!create_step_timer_) create_step_timer_ = lv_timer_create(CreateStepTimerCb, LV_DEF_REFR_PERIOD, this);
+        lv_timer_resume(create_step_timer_);
+    }
+    return page->heap_bytes_;
+}
+
+void UIManager::CreateStepTimerCb(lv_timer_t *t) {
+    UIManager *self = (UIManager *)lv_timer_get_user_data(t);
+    self->CreateStepTick();
+}
+
+void UIManager::CreateStepTick() {
+    auto start = std::chrono::steady_clock::now();
+    auto budget = std::chrono::milliseconds(create_step_budget_ms_);
+    while (!building_.empty()) {
+        /* The page on screen fills in before preloaded ones */
+        auto it = std::find(building_.begin(), building_.end(), current_page_);
+        if (it == building_.end()) it = building_.begin();
+        PageBase *page = *it;
+        PageArena *prev_arena = PageArena::Activate(page->arena_);
+        uint32_t before = HeapUsed();
+        bool more = page->DoCreateStep();
+        uint32_t after = HeapUsed();
+        if (after > before) page->heap_bytes_ += after - before;
+        if (!more) {
+            building_.erase(it);
+            if (page->GetContainer()) RestorePageState(page);
+        }
+        PageArena::Activate(prev_arena);
+        if (std::chrono::steady_clock::now() - start >= budget) break;
+    }
+    if (building_.empty()) lv_timer_pause(create_step_timer_);
+}
+
+bool UIManager::IsNeighbor(PageBase *from, PageBase *page) const {
+    if (!from || !page) return false;
+    for (Direction d : {Direction::Left, Direction::Right, Direction::Up, Direction::Down}) {
+        if (registry_.GetNeighbor(from, d) == page) return true;
+    }
+    return false;
+}
+
+void UIManager::ReleasePreloaded(PageBase *new_current) {
+    /* Preloads that are not one swipe away from the new page become ordinary cached pages */
+    for (auto it = preloaded_.begin(); it != preloaded_.end();) {
+        if (it->page == new_current || !IsNeighbor(new_current, it->page)) {
+            preload_bytes_ -= std::min(preload_bytes_, it->bytes);
+            if (it->page != new_current) {
+                it->page->state_ = PageState::Inactive;
+                inactive_cache_.push_back(it->page);
+            }
+            it = preloaded_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void UIManager::SchedulePreload() {
+    if (!preload_enabled_ || !initialized_) return;
+    if (!preload_timer_) {
+        preload_timer_ = lv_timer_create(PreloadTimerCb, kPreloadDelayMs, this);
+    }
+    lv_timer_reset(preload_timer_);
+    lv_timer_resume(preload_timer_);
+}
+
+void UIManager::PreloadTimerCb(lv_timer_t *t) {
+    UIManager *self = (UIManager *)lv_timer_get_user_data(t);
+    self->PreloadStep();
+}
+
+void UIManager::PreloadStep() {
+    if (!preload_enabled_ || is_animating_ || !current_page_ || pressure_ != MemoryPressure::Normal) {
+        lv_timer_pause(preload_timer_);
+        return;
+    }
+    for (Direction d : {Direction::Left, Direction::Right, Direction::Up, Direction::Down}) {
+        PageBase *page = registry_.GetNeighbor(current_page_, d);
+        if (!page || page == current_page_) continue;
+        if (page->GetState() != PageState::Registered && page->GetState() != PageState::Destroyed) continue;
+        if (preload_budget_ && preload_bytes_ >= preload_budget_) break;
+        /* One page per tick keeps each idle slice short */
+        uint32_t bytes = CreatePage(page);
+        if (page->GetContainer()) lv_obj_add_flag(page->GetContainer(), LV_OBJ_FLAG_HIDDEN);
+        preloaded_.push_back({page, bytes});
+        preload_bytes_ += bytes;
+        ESP_LOGI(TAG, "Preloaded '%s' (%u bytes)", page->GetId(), (unsigned)bytes);
+        return;
+    }
+    lv_timer_pause(preload_timer_);
+}
+
+void UIManager::BeginTransitionTiming() {
+    uint32_t duration = fling_time_ ? fling_time_ : transition_duration_;
+    fling_time_ = 0;
+    anim_time_ = duration;
+    if (!adaptive_) return;
+    last_frame_tick_ = 0;
+    frame_rendered_ = false;
+    uint32_t period = GetMeasuredFramePeriod();
+    adaptive_steps_ = period ? duration / period : duration;
+    if (adaptive_steps_ < adaptive_min_steps_) {
+        /* Too few frames to read as motion: finish in one frame instead of stuttering */
+        anim_time_ = std::min<uint32_t>(duration, period);
+        adaptive_steps_ = 1;
+    }
+    ESP_LOGD(TAG, "Adaptive transition: %u ms frames, %u steps over %u ms",
+             (unsigned)period, (unsigned)adaptive_steps_, (unsigned)anim_time_);
+}
+
+uint32_t UIManager::FlingDuration(int32_t velocity, int32_t remaining, int32_t span) const {
+    uint32_t normal = span > 0 ? (uint32_t)((uint64_t)transition_duration_ * remaining / span) : transition_duration_;
+    normal = std::max<uint32_t>(1, normal);
+    if (velocity < kFlingPxPerS || remaining <= 0) return normal;
+    /* ease_out starts at about 2.5x its average speed; pick the duration that matches the finger */
+    uint32_t matched = (uint32_t)((uint64_t)remaining * 2500 / (uint32_t)velocity);
+    return std::min(normal, std::max(matched, kFlingMinMs));
+}
+
+lv_anim_path_cb_t UIManager::TransitionPath(lv_anim_path_cb_t base) const {
+    if (!adaptive_) return base;
+    return base == lv_anim_path_ease_in_out ? AdaptiveEaseInOut : AdaptiveEaseOut;
+}
+
+int32_t UIManager::AdaptivePath(const lv_anim_t *a, lv_anim_path_cb_t base) {
+    const AnimContext *c = (const AnimContext *)a->user_data;
+    uint32_t steps = c && c->mgr ? c->mgr->adaptive_steps_ : 0;
+    if (steps == 0 || a->duration <= 0) return base(a);
+    /* Snap elapsed time to the start of its step so every frame advances by one even step */
+    lv_anim_t q = *a;
+    int32_t step = (int32_t)((int64_t)a->act_time * (int32_t)steps / a->duration);
+    q.act_time = (int32_t)((int64_t)step * a->duration / (int32_t)steps);
+    return base(&q);
+}
+
+void UIManager::AdaptiveRefrCb(lv_event_t *e) {
+    UIManager *self = (UIManager *)lv_event_get_user_data(e);
+    if (!self->is_animating_) return;
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_RENDER_START:
+            self->frame_rendered_ = true;
+            break;
+        case LV_EVENT_REFR_READY: {
+            if (!self->frame_rendered_) break;
+            self->frame_rendered_ = false;
+            uint32_t now = lv_tick_get();
+            if (self->last_frame_tick_) {
+                /* EMA with 1/4 weight, kept in 1/16 ms */
+                uint32_t interval_x16 = lv_tick_elaps(self->last_frame_tick_) * 16;
+                /* The running transition keeps its step grid: re-quantizing it could move the
+                   pages back to an earlier step; the new rate applies from the next transition */
+                self->frame_period_x16_ = (self->frame_period_x16_ * 3 + interval_x16) / 4;
+            }
+            self->last_frame_tick_ = now ? now : 1;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+lv_obj_t *UIManager::SnapshotPage(lv_obj_t *live, SnapshotLayer &layer) {
+#if LV_USE_SNAPSHOT
+    lv_obj_update_layout(live);
+    uint32_t w = (uint32_t)lv_obj_get_width(live);
+    uint32_t h = (uint32_t)lv_obj_get_height(live);
+    /* Page containers all share the page_container_ size, so the buffer is reused across transitions */
+    if (layer.buf && (layer.buf->header.w != w || layer.buf->header.h != h)) {
+        lv_draw_buf_destroy(layer.buf);
+        layer.buf = nullptr;
+    }
+    if (!layer.buf) layer.buf = lv_draw_buf_create(w, h, LV_COLOR_FORMAT_NATIVE, LV_STRIDE_AUTO);
+    if (!layer.buf || lv_snapshot_take_to_draw_buf(live, LV_COLOR_FORMAT_NATIVE, layer.buf) != LV_RESULT_OK) {
+        ESP_LOGW(TAG, "Page snapshot failed, animating live page");
+        return live;
+    }
+#if LVGL_VERSION_MAJOR > 9 || LVGL_VERSION_MINOR >= 1
+    lv_image_cache_drop(layer.buf);
+#endif
+    layer.img = lv_image_create(page_container_);
+    lv_image_set_src(layer.img, layer.buf);
+    lv_obj_set_pos(layer.img, lv_obj_get_x(live), lv_obj_get_y(live));
+    lv_obj_add_flag(live, LV_OBJ_FLAG_HIDDEN);
+    layer.live = live;
+    return layer.img;
+#else
+    (void)layer;
+    return live;
+#endif
+}
+
+void UIManager::ReleaseSnapshot(SnapshotLayer &layer) {
+    if (layer.img) {
+        lv_obj_delete(layer.img);
+        layer.img = nullptr;
+    }
+    if (layer.live) {
+        lv_obj_set_pos(layer.live, 0, 0);
+        lv_obj_clear_flag(layer.live, LV_OBJ_FLAG_HIDDEN);
+        layer.live = nullptr;
+    }
+}
+
+void UIManager::FreeSnapshotBuffers() {
+    for (SnapshotLayer *layer : {&snap_old_, &snap_new_}) {
+        if (layer->buf) {
+            lv_draw_buf_destroy(layer->buf);
+            layer->buf = nullptr;
+        }
     }
 }
 
 void UIManager::DoSlideTransition(lv_obj_t *old_obj, lv_obj_t *new_obj, PageBase *old_page, PageBase *target, Direction dir) {
     is_animating_ = true;
+    frame_metrics_.BeginTransition(TransitionType::Slide);
+    BeginTransitionTiming();
+    anim_ctx_ = {this, old_page, target};
     int32_t w = lv_obj_get_width(page_container_);
     int32_t h = lv_obj_get_height(page_container_);
     int32_t start_x = 0, start_y = 0, end_x = 0, end_y = 0;
@@ -183,11 +1050,15 @@ void UIManager::DoSlideTransition(lv_obj_t *old_obj, lv_obj_t *new_obj, PageBase
 
     lv_obj_set_pos(new_obj, start_x, start_y);
     lv_obj_clear_flag(new_obj, LV_OBJ_FLAG_HIDDEN);
+    if (snapshot_mode_ != SnapshotMode::Off) {
+        old_obj = SnapshotPage(old_obj, snap_old_);
+        if (snapshot_mode_ == SnapshotMode::Both) new_obj = SnapshotPage(new_obj, snap_new_);
+    }
 
     lv_anim_t anim_new;
     lv_anim_init(&anim_new);
     lv_anim_set_var(&anim_new, new_obj);
-    lv_anim_set_time(&anim_new, transition_duration_);
+    lv_anim_set_time(&anim_new, anim_time_);
     if (dir == Direction::Left || dir == Direction::Right) {
         lv_anim_set_values(&anim_new, start_x, 0);
         lv_anim_set_exec_cb(&anim_new, [](void *obj, int32_t v) { lv_obj_set_x((lv_obj_t *)obj, v); });
@@ -195,13 +1066,14 @@ void UIManager::DoSlideTransition(lv_obj_t *old_obj, lv_obj_t *new_obj, PageBase
         lv_anim_set_values(&anim_new, start_y, 0);
         lv_anim_set_exec_cb(&anim_new, [](void *obj, int32_t v) { lv_obj_set_y((lv_obj_t *)obj, v); });
     }
-    lv_anim_set_path_cb(&anim_new, lv_anim_path_ease_out);
-    lv_anim_start(&anim_new);
+    lv_anim_set_path_cb(&anim_new, TransitionPath(lv_anim_path_ease_out));
+    lv_anim_set_user_data(&anim_new, &anim_ctx_);
+    TrackAnim(lv_anim_start(&anim_new));
 
     lv_anim_t anim_old;
     lv_anim_init(&anim_old);
     lv_anim_set_var(&anim_old, old_obj);
-    lv_anim_set_time(&anim_old, transition_duration_);
+    lv_anim_set_time(&anim_old, anim_time_);
     if (dir == Direction::Left || dir == Direction::Right) {
         lv_anim_set_values(&anim_old, 0, end_x);
         lv_anim_set_exec_cb(&anim_old, [](void *obj, int32_t v) { lv_obj_set_x((lv_obj_t *)obj, v); });
@@ -209,22 +1081,24 @@ void UIManager::DoSlideTransition(lv_obj_t *old_obj, lv_obj_t *new_obj, PageBase
         lv_anim_set_values(&anim_old, 0, end_y);
         lv_anim_set_exec_cb(&anim_old, [](void *obj, int32_t v) { lv_obj_set_y((lv_obj_t *)obj, v); });
     }
-    lv_anim_set_path_cb(&anim_old, lv_anim_path_ease_out);
+    lv_anim_set_path_cb(&anim_old, TransitionPath(lv_anim_path_ease_out));
 
-    anim_ctx_ = {this, old_page, target};
     lv_anim_set_completed_cb(&anim_old, [](lv_anim_t *a) {
         AnimContext *c = (AnimContext *)a->user_data;
-        if (c->old_p && c->old_p->GetContainer()) {
-            lv_obj_set_pos(c->old_p->GetContainer(), 0, 0);
+        if (c->Leaving() && c->Leaving()->GetContainer()) {
+            lv_obj_set_pos(c->Leaving()->GetContainer(), 0, 0);
         }
         c->mgr->OnAnimationComplete(c->old_p, c->new_p);
     });
     lv_anim_set_user_data(&anim_old, &anim_ctx_);
-    lv_anim_start(&anim_old);
+    TrackAnim(lv_anim_start(&anim_old));
 }
 
 void UIManager::DoSlideOverTransition(lv_obj_t *old_obj, lv_obj_t *new_obj, PageBase *old_page, PageBase *target, Direction dir) {
     is_animating_ = true;
+    frame_metrics_.BeginTransition(TransitionType::SlideOver);
+    BeginTransitionTiming();
+    anim_ctx_ = {this, old_page, target};
     int32_t w = lv_obj_get_width(page_container_);
     int32_t h = lv_obj_get_height(page_container_);
     int32_t start_x = 0, start_y = 0;
@@ -237,12 +1111,16 @@ void UIManager::DoSlideOverTransition(lv_obj_t *old_obj, lv_obj_t *new_obj, Page
 
     lv_obj_set_pos(new_obj, start_x, start_y);
     lv_obj_clear_flag(new_obj, LV_OBJ_FLAG_HIDDEN);
+    if (snapshot_mode_ != SnapshotMode::Off) {
+        old_obj = SnapshotPage(old_obj, snap_old_);
+        if (snapshot_mode_ == SnapshotMode::Both) new_obj = SnapshotPage(new_obj, snap_new_);
+    }
     lv_obj_move_to_index(new_obj, -1); /* bring new page to front */
 
     lv_anim_t anim_new;
     lv_anim_init(&anim_new);
     lv_anim_set_var(&anim_new, new_obj);
-    lv_anim_set_time(&anim_new, transition_duration_);
+    lv_anim_set_time(&anim_new, anim_time_);
     if (dir == Direction::Left || dir == Direction::Right) {
         lv_anim_set_values(&anim_new, start_x, 0);
         lv_anim_set_exec_cb(&anim_new, [](void *obj, int32_t v) { lv_obj_set_x((lv_obj_t *)obj, v); });
@@ -250,19 +1128,22 @@ void UIManager::DoSlideOverTransition(lv_obj_t *old_obj, lv_obj_t *new_obj, Page
         lv_anim_set_values(&anim_new, start_y, 0);
         lv_anim_set_exec_cb(&anim_new, [](void *obj, int32_t v) { lv_obj_set_y((lv_obj_t *)obj, v); });
     }
-    lv_anim_set_path_cb(&anim_new, lv_anim_path_ease_out);
+    lv_anim_set_path_cb(&anim_new, TransitionPath(lv_anim_path_ease_out));
 
-    anim_ctx_ = {this, old_page, target};
     lv_anim_set_completed_cb(&anim_new, [](lv_anim_t *a) {
         AnimContext *c = (AnimContext *)a->user_data;
+        if (c->reversed && c->new_p->GetContainer()) lv_obj_set_pos(c->new_p->GetContainer(), 0, 0);
         c->mgr->OnAnimationComplete(c->old_p, c->new_p);
     });
     lv_anim_set_user_data(&anim_new, &anim_ctx_);
-    lv_anim_start(&anim_new);
+    TrackAnim(lv_anim_start(&anim_new));
 }
 
 void UIManager::DoFadeTransition(lv_obj_t *old_obj, lv_obj_t *new_obj, PageBase *old_page, PageBase *target) {
     is_animating_ = true;
+    frame_metrics_.BeginTransition(TransitionType::Fade);
+    BeginTransitionTiming();
+    anim_ctx_ = {this, old_page, target};
     lv_obj_set_pos(new_obj, 0, 0);
     lv_obj_set_style_opa(new_obj, LV_OPA_TRANSP, 0);
     lv_obj_clear_flag(new_obj, LV_OBJ_FLAG_HIDDEN);
@@ -271,49 +1152,226 @@ void UIManager::DoFadeTransition(lv_obj_t *old_obj, lv_obj_t *new_obj, PageBase
     lv_anim_init(&anim_new);
     lv_anim_set_var(&anim_new, new_obj);
     lv_anim_set_values(&anim_new, LV_OPA_TRANSP, LV_OPA_COVER);
-    lv_anim_set_time(&anim_new, transition_duration_);
+    lv_anim_set_time(&anim_new, anim_time_);
     lv_anim_set_exec_cb(&anim_new, [](void *obj, int32_t v) { lv_obj_set_style_opa((lv_obj_t *)obj, v, 0); });
-    lv_anim_set_path_cb(&anim_new, lv_anim_path_ease_in_out);
-    lv_anim_start(&anim_new);
+    lv_anim_set_path_cb(&anim_new, TransitionPath(lv_anim_path_ease_in_out));
+    lv_anim_set_user_data(&anim_new, &anim_ctx_);
+    TrackAnim(lv_anim_start(&anim_new));
 
     lv_anim_t anim_old;
     lv_anim_init(&anim_old);
     lv_anim_set_var(&anim_old, old_obj);
     lv_anim_set_values(&anim_old, LV_OPA_COVER, LV_OPA_TRANSP);
-    lv_anim_set_time(&anim_old, transition_duration_);
+    lv_anim_set_time(&anim_old, anim_time_);
     lv_anim_set_exec_cb(&anim_old, [](void *obj, int32_t v) { lv_obj_set_style_opa((lv_obj_t *)obj, v, 0); });
-    lv_anim_set_path_cb(&anim_old, lv_anim_path_ease_in_out);
+    lv_anim_set_path_cb(&anim_old, TransitionPath(lv_anim_path_ease_in_out));
 
-    anim_ctx_ = {this, old_page, target};
     lv_anim_set_completed_cb(&anim_old, [](lv_anim_t *a) {
         AnimContext *c = (AnimContext *)a->user_data;
-        if (c->old_p && c->old_p->GetContainer()) {
-            lv_obj_set_style_opa(c->old_p->GetContainer(), LV_OPA_COVER, 0);
+        if (c->Leaving() && c->Leaving()->GetContainer()) {
+            lv_obj_set_style_opa(c->Leaving()->GetContainer(), LV_OPA_COVER, 0);
         }
         c->mgr->OnAnimationComplete(c->old_p, c->new_p);
     });
     lv_anim_set_user_data(&anim_old, &anim_ctx_);
-    lv_anim_start(&anim_old);
+    TrackAnim(lv_anim_start(&anim_old));
+}
+
+void UIManager::DoBufferScrollTransition(lv_obj_t *old_obj, lv_obj_t *new_obj, PageBase *old_page, PageBase *target, Direction dir) {
+    is_animating_ = true;
+    frame_metrics_.BeginTransition(TransitionType::BufferScroll);
+    BeginTransitionTiming();
+    anim_ctx_ = {this, old_page, target};
+    int32_t w = lv_obj_get_width(page_container_);
+    int32_t h = lv_obj_get_height(page_container_);
+    int32_t span = 0;
+    switch (dir) {
+        case Direction::Left:  span = w;   break;
+        case Direction::Right: span = -w;  break;
+        case Direction::Up:    span = h;   break;
+        case Direction::Down:  span = -h;  break;
+    }
+    bool horizontal = dir == Direction::Left || dir == Direction::Right;
+    lv_obj_set_pos(new_obj, horizontal ? span : 0, horizontal ? 0 : span);
+    lv_obj_clear_flag(new_obj, LV_OBJ_FLAG_HIDDEN);
+    scroll_ = {old_obj, new_obj, dir, span, span, 0};
+    if (scroll_shift_cb_) {
+        lv_display_add_event_cb(lv_obj_get_display(page_container_), BufferScrollRefrCb, LV_EVENT_REFR_READY, this);
+    }
+
+    /* One animation drives both pages: they move by the same delta every frame */
+    lv_anim_t anim;
+    lv_anim_init(&anim);
+    lv_anim_set_var(&anim, this);
+    lv_anim_set_time(&anim, anim_time_);
+    lv_anim_set_values(&anim, span, 0);
+    lv_anim_set_exec_cb(&anim, BufferScrollExecCb);
+    lv_anim_set_path_cb(&anim, TransitionPath(lv_anim_path_ease_out));
+
+    lv_anim_set_completed_cb(&anim, [](lv_anim_t *a) {
+        AnimContext *c = (AnimContext *)a->user_data;
+        UIManager *mgr = c->mgr;
+        lv_display_remove_event_cb_with_user_data(lv_obj_get_display(mgr->page_container_), BufferScrollRefrCb, mgr);
+        if (c->Leaving() && c->Leaving()->GetContainer()) {
+            /* Hide before re-homing so the reset does not invalidate the whole screen */
+            lv_obj_add_flag(c->Leaving()->GetContainer(), LV_OBJ_FLAG_HIDDEN);
+            lv_obj_set_pos(c->Leaving()->GetContainer(), 0, 0);
+        }
+        mgr->scroll_ = ScrollContext();
+        mgr->OnAnimationComplete(c->old_p, c->new_p);
+    });
+    lv_anim_set_user_data(&anim, &anim_ctx_);
+    TrackAnim(lv_anim_start(&anim));
+}
+
+void UIManager::BufferScrollExecCb(void *var, int32_t v) {
+    ((UIManager *)var)->BufferScrollStep(v);
+}
+
+void UIManager::BufferScrollRefrCb(lv_event_t *e) {
+    UIManager *self = (UIManager *)lv_event_get_user_data(e);
+    self->scroll_.pending = 0;
+}
+
+void UIManager::BufferScrollStep(int32_t v) {
+    ScrollContext &sc = scroll_;
+    int32_t delta = v - sc.last;
+    if (delta == 0 || !sc.new_obj) return;
+    sc.last = v;
+    bool horizontal = sc.dir == Direction::Left || sc.dir == Direction::Right;
+    auto place = [&]() {
+        if (horizontal) {
+            lv_obj_set_x(sc.new_obj, v);
+            lv_obj_set_x(sc.old_obj, v - sc.span);
+        } else {
+            lv_obj_set_y(sc.new_obj, v);
+            lv_obj_set_y(sc.old_obj, v - sc.span);
+        }
+    };
+    lv_display_t *disp = lv_obj_get_display(page_container_);
+    lv_area_t area;
+    lv_obj_get_coords(page_container_, &area);
+    int32_t dx = horizontal ? delta : 0;
+    int32_t dy = horizontal ? 0 : delta;
+
+    /* Move the pages without invalidating them, then let the callback move the pixels */
+    lv_display_enable_invalidation(disp, false);
+    place();
+    lv_display_enable_invalidation(disp, true);
+    if (!scroll_shift_cb_ || !scroll_shift_cb_(disp, &area, dx, dy, scroll_shift_user_data_)) {
+        lv_obj_invalidate(page_container_);
+        return;
+    }
+
+    /* Only the strip that scrolled in needs rendering. Strips exposed by earlier steps but not
+       yet rendered were shifted inward along with everything else, so they stay in the strip. */
+    sc.pending += delta < 0 ? -delta : delta;
+    lv_area_t strip = area;
+    if (horizontal) {
+        int32_t len = std::min(sc.pending, area.x2 - area.x1 + 1);
+        if (delta < 0) strip.x1 = area.x2 - len + 1;
+        else strip.x2 = area.x1 + len - 1;
+    } else {
+        int32_t len = std::min(sc.pending, area.y2 - area.y1 + 1);
+        if (delta < 0) strip.y1 = area.y2 - len + 1;
+        else strip.y2 = area.y1 + len - 1;
+    }
+    lv_inv_area(disp, &strip);
+
+    /* Top-layer overlays (status bar, dialogs) were shifted too: redraw them and their moved copy */
+    lv_obj_t *top = lv_display_get_layer_top(disp);
+    uint32_t n = top ? lv_obj_get_child_count(top) : 0;
+    for (uint32_t i = 0; i < n; i++) {
+        lv_obj_t *child = lv_obj_get_child(top, (int32_t)i);
+        if (lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+        lv_area_t a;
+        lv_obj_get_coords(child, &a);
+        lv_inv_area(disp, &a);
+        lv_area_move(&a, dx, dy);
+        lv_inv_area(disp, &a);
+    }
 }
 
 void UIManager::OnGestureDetected(Direction dir) {
-    if (!gesture_enabled_ || is_animating_ || !current_page_) return;
+    if (!gesture_enabled_ || !current_page_ || drag_.phase != DragContext::Phase::Idle) return;
+    if (is_animating_) {
+        /* Swiping back towards the page being left reverses the transition */
+        if (interruptible_ && registry_.GetNeighbor(current_page_, dir) == anim_ctx_.Leaving()) {
+            lv_indev_wait_release(lv_indev_active());
+            ReverseTransition();
+        }
+        return;
+    }
     lv_indev_wait_release(lv_indev_active());
 
     PageBase *target = nullptr;
     Direction anim_dir = dir;
     TransitionType anim_type = TransitionType::Slide;
 
-    if (registry_.GetNavigationTarget(current_page_->GetId(), dir, target, anim_dir, anim_type)) {
+    if (registry_.GetNavigationTarget(current_page_, dir, target, anim_dir, anim_type)) {
         ESP_LOGI(TAG, "Gesture %s on '%s' -> '%s'", DirectionToString(dir), current_page_->GetId(), target->GetId());
+        int32_t velocity = PointerVelocity(dir);
+        bool horizontal = anim_dir == Direction::Left || anim_dir == Direction::Right;
+        int32_t span = horizontal ? lv_obj_get_width(page_container_) : lv_obj_get_height(page_container_);
+        fling_time_ = FlingDuration(velocity, span, span);
         DoNavigate(target, anim_dir, anim_type);
+        fling_time_ = 0;
     }
 }
 
+void UIManager::PointerTimerCb(lv_timer_t *t) {
+    UIManager *self = (UIManager *)lv_timer_get_user_data(t);
+    self->SamplePointer();
+}
+
+void UIManager::SamplePointer() {
+    lv_indev_t *indev = indev_;
+    if (!indev) {
+        for (lv_indev_t *i = lv_indev_get_next(nullptr); i; i = lv_indev_get_next(i)) {
+            if (lv_indev_get_type(i) != LV_INDEV_TYPE_POINTER || lv_indev_get_display(i) != GetDisplay()) continue;
+            if (lv_indev_get_state(i) == LV_INDEV_STATE_PRESSED) {
+                indev = i;
+                break;
+            }
+        }
+    }
+    if (!indev || lv_indev_get_state(indev) != LV_INDEV_STATE_PRESSED) {
+        pointer_sample_count_ = 0;
+        return;
+    }
+    PointerSample &s = pointer_samples_[pointer_sample_head_];
+    s.tick = lv_tick_get();
+    lv_indev_get_point(indev, &s.point);
+    pointer_sample_head_ = (pointer_sample_head_ + 1) % kPointerSamples;
+    if (pointer_sample_count_ < kPointerSamples) pointer_sample_count_++;
+}
+
+int32_t UIManager::PointerVelocity(Direction dir) {
+    /* The gesture fires mid-read: the point it fired at is the newest sample */
+    if (lv_indev_t *indev = lv_indev_active()) {
+        if (lv_indev_get_state(indev) == LV_INDEV_STATE_PRESSED) SamplePointer();
+    }
+    if (pointer_sample_count_ < 2) return 0;
+    const PointerSample &newest = pointer_samples_[(pointer_sample_head_ + kPointerSamples - 1) % kPointerSamples];
+    const PointerSample *oldest = &newest;
+    for (size_t i = 1; i < pointer_sample_count_; i++) {
+        const PointerSample &s = pointer_samples_[(pointer_sample_head_ + kPointerSamples - 1 - i) % kPointerSamples];
+        if (newest.tick - s.tick > kVelocityWindowMs) break;
+        oldest = &s;
+    }
+    uint32_t dt = newest.tick - oldest->tick;
+    if (dt == 0) return 0;
+    int32_t dx = newest.point.x - oldest->point.x;
+    int32_t dy = newest.point.y - oldest->point.y;
+    int32_t along = dir == Direction::Left ? -dx : dir == Direction::Right ? dx
+                  : dir == Direction::Up ? -dy : dy;
+    return (int32_t)((int64_t)along * 1000 / dt);
+}
+
 void UIManager::GestureEventCb(lv_event_t *e) {
     UIManager *self = (UIManager *)lv_event_get_user_data(e);
     lv_indev_t *indev = lv_indev_active();
-    if (!indev) return;
+    if (!indev || (self->indev_ && indev != self->indev_)) return;
     lv_dir_t gdir = lv_indev_get_gesture_dir(indev);
     Direction dir;
     switch (gdir) {
@@ -326,4 +1384,186 @@ void UIManager::GestureEventCb(lv_event_t *e) {
     self->OnGestureDetected(dir);
 }
 
+void UIManager::DragEventCb(lv_event_t *e) {
+    UIManager *self = (UIManager *)lv_event_get_user_data(e);
+    self->OnDragEvent(lv_event_get_code(e));
+}
+
+void UIManager::OnDragEvent(lv_event_code_t code) {
+    lv_indev_t *indev = lv_indev_active();
+    if (!indev || (indev_ && indev != indev_)) return;
+    DragContext &d = drag_;
+    lv_point_t p;
+    lv_indev_get_point(indev, &p);
+    switch (code) {
+        case LV_EVENT_PRESSED:
+            if (!gesture_enabled_ || is_animating_ || !current_page_) return;
+            d.phase = DragContext::Phase::Pending;
+            d.start = p;
+            break;
+        case LV_EVENT_PRESSING: {
+            if (d.phase == DragContext::Phase::Idle) return;
+            int32_t dx = p.x - d.start.x;
+            int32_t dy = p.y - d.start.y;
+            if (d.phase == DragContext::Phase::Pending) {
+                int32_t adx = dx < 0 ? -dx : dx;
+                int32_t ady = dy < 0 ? -dy : dy;
+                if (std::max(adx, ady) < kDragStartPx) return;
+                /* A scrolling child owns this press */
+                if (lv_indev_get_scroll_obj(indev)) {
+                    d.phase = DragContext::Phase::Idle;
+                    return;
+                }
+                Direction dir = adx > ady ? (dx < 0 ? Direction::Left : Direction::Right)
+                                          : (dy < 0 ? Direction::Up : Direction::Down);
+                if (!BeginDrag(dir)) {
+                    d.phase = DragContext::Phase::Idle;
+                    return;
+                }
+            }
+            bool horizontal = d.anim_dir == Direction::Left || d.anim_dir == Direction::Right;
+            int32_t moved = -d.sign * (horizontal ? dx : dy);
+            int32_t progress = std::max<int32_t>(0, std::min(moved, d.span));
+            uint32_t now = lv_tick_get();
+            uint32_t dt = lv_tick_elaps(d.last_tick);
+            if (dt > 0) {
+                int32_t v = (progress - d.progress) * 1000 / (int32_t)dt;
+                d.velocity = (d.velocity + v) / 2;
+                d.last_tick = now;
+            }
+            PlaceDrag(progress);
+            break;
+        }
+        case LV_EVENT_RELEASED:
+        case LV_EVENT_PRESS_LOST:
+            if (d.phase == DragContext::Phase::Dragging) {
+                /* A stale sample (finger held still) means no fling */
+                if (lv_tick_elaps(d.last_tick) > 100) d.velocity = 0;
+                bool commit = d.velocity > kFlingPxPerS ||
+                              (d.velocity > -kFlingPxPerS && d.progress * 3 > d.span);
+                EndDrag(commit);
+            }
+            d.phase = DragContext::Phase::Idle;
+            break;
+        default:
+            break;
+    }
+}
+
+bool UIManager::BeginDrag(Direction gesture_dir) {
+    DragContext &d = drag_;
+    PageBase *target = nullptr;
+    Direction anim_dir = gesture_dir;
+    TransitionType type = TransitionType::Slide;
+    if (!registry_.GetNavigationTarget(current_page_, gesture_dir, target, anim_dir, type)) return false;
+    if (target == current_page_ || !ClaimPage(target)) return false;
+    /* Fade and None have no position to follow; the release gesture handles them */
+    if (type != TransitionType::Slide && type != TransitionType::SlideOver && type != TransitionType::BufferScroll) {
+        return false;
+    }
+    auto cache_it = std::find(inactive_cache_.begin(), inactive_cache_.end(), target);
+    if (cache_it != inactive_cache_.end()) inactive_cache_.erase(cache_it);
+    if (preload_timer_) lv_timer_pause(preload_timer_);
+    if (target->GetState() == PageState::Registered || target->GetState() == PageState::Destroyed) {
+        CreatePage(target);
+    }
+    if (!target->GetContainer()) return false;
+
+    bool horizontal = anim_dir == Direction::Left || anim_dir == Direction::Right;
+    d.phase = DragContext::Phase::Dragging;
+    d.target = target;
+    d.anim_dir = anim_dir;
+    d.type = type == TransitionType::SlideOver ? TransitionType::SlideOver : TransitionType::Slide;
+    d.span = horizontal ? lv_obj_get_width(page_container_) : lv_obj_get_height(page_container_);
+    d.sign = (anim_dir == Direction::Left || anim_dir == Direction::Up) ? 1 : -1;
+    d.progress = -1;
+    d.velocity = 0;
+    d.last_tick = lv_tick_get();
+    is_animating_ = true;
+    lv_obj_clear_flag(target->GetContainer(), LV_OBJ_FLAG_HIDDEN);
+    if (d.type == TransitionType::SlideOver) lv_obj_move_to_index(target->GetContainer(), -1);
+    PlaceDrag(0);
+    ESP_LOGI(TAG, "Drag %s on '%s' -> '%s'", DirectionToString(gesture_dir), current_page_->GetId(), target->GetId());
+    return true;
+}
+
+void UIManager::PlaceDrag(int32_t progress) {
+    DragContext &d = drag_;
+    if (progress == d.progress) return;
+    d.progress = progress;
+    /* One or two position updates per input sample, nothing else */
+    lv_obj_t *new_obj = d.target->GetContainer();
+    lv_obj_t *old_obj = current_page_->GetContainer();
+    int32_t new_off = d.sign * (d.span - progress);
+    int32_t old_off = -d.sign * progress;
+    if (d.anim_dir == Direction::Left || d.anim_dir == Direction::Right) {
+        lv_obj_set_pos(new_obj, new_off, 0);
+        if (d.type == TransitionType::Slide) lv_obj_set_pos(old_obj, old_off, 0);
+    } else {
+        lv_obj_set_pos(new_obj, 0, new_off);
+        if (d.type == TransitionType::Slide) lv_obj_set_pos(old_obj, 0, old_off);
+    }
+}
+
+void UIManager::EndDrag(bool commit) {
+    DragContext &d = drag_;
+    d.phase = DragContext::Phase::Idle;
+    PageBase *old_page = current_page_;
+    PageBase *target = d.target;
+    frame_metrics_.BeginTransition(d.type);
+    int32_t remaining = commit ? d.span - d.progress : d.progress;
+    fling_time_ = FlingDuration(commit ? d.velocity : -d.velocity, remaining, d.span);
+    BeginTransitionTiming();
+    anim_ctx_ = {this, old_page, target};
+    anim_ctx_.reversed = !commit;
+    HistoryEntry entry = {old_page, d.anim_dir, d.type};
+    anim_ctx_.history_pushed = entry;
+    if (commit) {
+        PushHistory(entry);
+        ReleasePreloaded(target);
+        current_page_ = target;
+    }
+    ESP_LOGI(TAG, "Drag %s at %d/%d px", commit ? "committed" : "cancelled", (int)d.progress, (int)d.span);
+
+    /* Finish from where the finger left the pages */
+    uint32_t time = anim_time_;
+    bool horizontal = d.anim_dir == Direction::Left || d.anim_dir == Direction::Right;
+    lv_anim_exec_xcb_t exec = horizontal ? [](void *obj, int32_t v) { lv_obj_set_x((lv_obj_t *)obj, v); }
+                                         : [](void *obj, int32_t v) { lv_obj_set_y((lv_obj_t *)obj, v); };
+    struct Leg { lv_obj_t *obj; int32_t from, to; };  /* forward endpoints */
+    Leg legs[2] = {{target->GetContainer(), d.sign * d.span, 0}, {old_page->GetContainer(), 0, -d.sign * d.span}};
+    int n = d.type == TransitionType::Slide ? 2 : 1;
+    for (int i = 0; i < n; i++) {
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, legs[i].obj);
+        lv_anim_set_time(&a, time);
+        int32_t cur = horizontal ? lv_obj_get_x(legs[i].obj) : lv_obj_get_y(legs[i].obj);
+        lv_anim_set_values(&a, cur, commit ? legs[i].to : legs[i].from);
+        lv_anim_set_exec_cb(&a, exec);
+        lv_anim_set_path_cb(&a, TransitionPath(lv_anim_path_ease_out));
+        lv_anim_set_user_data(&a, &anim_ctx_);
+        if (i == n - 1) {
+            /* Started last, so LVGL runs it first; OnAnimationComplete snaps the other one */
+            lv_anim_set_completed_cb(&a, [](lv_anim_t *a) {
+                AnimContext *c = (AnimContext *)a->user_data;
+                if (c->Leaving() && c->Leaving()->GetContainer()) {
+                    lv_obj_set_pos(c->Leaving()->GetContainer(), 0, 0);
+                }
+                c->mgr->OnAnimationComplete(c->old_p, c->new_p);
+            });
+        }
+        TrackAnim(lv_anim_start(&a));
+        anim_ctx_.tracks[i].from = legs[i].from;
+        anim_ctx_.tracks[i].to = legs[i].to;
+    }
+}
+
+bool UIManager::IsPreloaded(const PageBase *page) const {
+    for (const PreloadedPage &p : preloaded_) {
+        if (p.page == page) return true;
+    }
+    return false;
+}
+
 } // namespace ui